@@ -0,0 +1,13 @@
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+in float v_TexIndex;
+
+uniform sampler2DArray u_TextureArray;
+
+void main() {
+	color = texture(u_TextureArray, vec3(v_TexCoord, v_TexIndex)) * v_Color;
+}
\ No newline at end of file
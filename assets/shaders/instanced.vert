@@ -0,0 +1,30 @@
+#version 330 core
+
+layout(location = 0) in vec2 a_Corner;
+layout(location = 1) in vec2 a_Center;
+layout(location = 2) in vec2 a_Size;
+layout(location = 3) in float a_Rotation;
+layout(location = 4) in float a_Depth;
+layout(location = 5) in vec4 a_UVRect;
+layout(location = 6) in vec4 a_Color;
+layout(location = 7) in float a_TexIndex;
+
+layout(std140) uniform GlobalData {
+	mat4 u_ViewProjection;
+};
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+out float v_TexIndex;
+
+void main() {
+	vec2 local = (a_Corner - 0.5) * a_Size;
+	float c = cos(a_Rotation);
+	float s = sin(a_Rotation);
+	vec2 position = a_Center + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+	v_Color = a_Color;
+	v_TexCoord = mix(a_UVRect.xy, a_UVRect.zw, a_Corner);
+	v_TexIndex = a_TexIndex;
+	gl_Position = u_ViewProjection * vec4(position, a_Depth, 1.0);
+}
\ No newline at end of file
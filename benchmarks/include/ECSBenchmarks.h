@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Harness.h"
+
+namespace Blackthorn::Benchmarks {
+
+// Every case runs once per StorageMode and entity count, so a storage
+// backend can be compared against the sparse-set ComponentArray directly.
+void registerECSBenchmarks(Runner& runner);
+
+} // namespace Blackthorn::Benchmarks
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Blackthorn::Benchmarks {
+
+// Keeps the compiler from discarding a value computed only for timing.
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+// Passed to every case. Whatever the case does before measure() is setup
+// and not timed. measure() first finds how many calls fill one sample, then
+// takes `repetitions` samples of that many calls.
+class State {
+private:
+	double minTime;
+	size_t repetitions;
+	size_t iterations = 0;
+	size_t items = 0;
+	std::vector<double> samples;
+
+	friend class Runner;
+
+	template <typename Function>
+	static double timeCalls(Function& function, size_t calls) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < calls; ++i)
+			function();
+
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+public:
+	State(double minTimeSeconds, size_t sampleCount)
+		: minTime(minTimeSeconds)
+		, repetitions(std::max<size_t>(1, sampleCount))
+	{}
+
+	template <typename Function>
+	void measure(Function&& function) {
+		double target = minTime * 1e9 / static_cast<double>(repetitions);
+		size_t calls = 1;
+		double elapsed = timeCalls(function, calls);
+
+		while (elapsed < target && calls < (size_t(1) << 30)) {
+			double scale = elapsed > 0.0 ? std::min(10.0, std::max(2.0, 1.2 * target / elapsed)) : 10.0;
+			calls = static_cast<size_t>(static_cast<double>(calls) * scale);
+			elapsed = timeCalls(function, calls);
+		}
+
+		iterations = calls;
+		samples.clear();
+
+		for (size_t i = 0; i < repetitions; ++i)
+			samples.push_back(timeCalls(function, calls) / static_cast<double>(calls));
+	}
+
+	// Work items one call handles (entities, components), for items/s.
+	void setItemsPerIteration(size_t count) { items = count; }
+};
+
+struct Case {
+	std::string name;
+	std::string storage;
+	size_t entities = 0;
+	std::function<void(State&)> body;
+};
+
+struct Result {
+	std::string name;
+	std::string storage;
+	size_t entities = 0;
+	size_t iterations = 0;
+	size_t repetitions = 0;
+	double minNs = 0.0;
+	double medianNs = 0.0;
+	double meanNs = 0.0;
+	double itemsPerSecond = 0.0;
+};
+
+// Runs registered cases and reports them as a table on stdout and, with
+// --json, as a JSON document meant for diffing between runs.
+//
+//   --filter=<text>     only cases whose full name contains <text>
+//   --min-time=<sec>    time spent sampling each case (default 0.5)
+//   --repetitions=<n>   samples per case (default 5)
+//   --json=<path>       write results to <path>, or stdout for "-"
+class Runner {
+private:
+	std::vector<Case> cases;
+	std::vector<Result> results;
+
+	std::string filter;
+	std::string jsonPath;
+	double minTime = 0.5;
+	size_t repetitions = 5;
+
+	bool parseArguments(int argc, char** argv);
+	Result runCase(const Case& benchmark) const;
+	void printRow(const Result& result) const;
+	bool writeJson() const;
+
+public:
+	void add(std::string name, std::string storage, size_t entities, std::function<void(State&)> body);
+	int run(int argc, char** argv);
+};
+
+} // namespace Blackthorn::Benchmarks
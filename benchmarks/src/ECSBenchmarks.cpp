@@ -0,0 +1,156 @@
+#include "ECSBenchmarks.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "ECS/Components/Kinematics.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/WorldTransform.h"
+#include "ECS/EntityPool.h"
+#include "ECS/Systems/KinematicsSystem.h"
+
+namespace Blackthorn::Benchmarks {
+
+namespace {
+
+using namespace ECS;
+using namespace ECS::Components;
+
+constexpr size_t ENTITY_COUNTS[] = { 1000, 10000, 100000 };
+constexpr StorageMode STORAGE_MODES[] = { StorageMode::SparseSet, StorageMode::Archetype };
+constexpr float FIXED_STEP = 1.0f / 60.0f;
+constexpr unsigned SEED = 1234;
+
+const char* storageName(StorageMode mode) {
+	return mode == StorageMode::SparseSet ? "SparseSet" : "Archetype";
+}
+
+std::vector<Entity> populate(EntityPool& pool, size_t count) {
+	std::vector<Entity> entities = pool.createMany(count);
+	pool.addComponents(entities, Transform{}, Kinematics{}, WorldTransform{});
+	return entities;
+}
+
+void createDestroy(State& state, StorageMode mode, size_t count) {
+	EntityPool pool(count, mode);
+	std::vector<Entity> entities(count);
+
+	state.setItemsPerIteration(count);
+	state.measure([&] {
+		for (Entity& entity : entities)
+			entity = pool.create();
+
+		for (Entity entity : entities)
+			pool.destroy(entity);
+	});
+}
+
+void addRemove(State& state, StorageMode mode, size_t count) {
+	EntityPool pool(count, mode);
+	std::vector<Entity> entities = pool.createMany(count);
+	pool.addComponents(entities, Transform{});
+
+	state.setItemsPerIteration(count);
+	state.measure([&] {
+		for (Entity entity : entities)
+			pool.addComponent<Kinematics>(entity);
+
+		for (Entity entity : entities)
+			pool.removeComponent<Kinematics>(entity);
+	});
+}
+
+void view1(State& state, StorageMode mode, size_t count) {
+	EntityPool pool(count, mode);
+	populate(pool, count);
+
+	state.setItemsPerIteration(count);
+	state.measure([&] {
+		pool.view<Transform>().each([](Entity, Transform& t) {
+			t.position.x += 1.0f;
+		});
+	});
+}
+
+void iterateView2(State& state, EntityPool& pool) {
+	state.setItemsPerIteration(pool.aliveCount());
+	state.measure([&] {
+		pool.view<Transform, const Kinematics>().each([](Entity, Transform& t, const Kinematics& k) {
+			t.position += k.acceleration;
+		});
+	});
+}
+
+void view2(State& state, StorageMode mode, size_t count) {
+	EntityPool pool(count, mode);
+	populate(pool, count);
+	iterateView2(state, pool);
+}
+
+void view3(State& state, StorageMode mode, size_t count) {
+	EntityPool pool(count, mode);
+	populate(pool, count);
+
+	state.setItemsPerIteration(count);
+	state.measure([&] {
+		pool.view<Transform, const Kinematics, const WorldTransform>().each([](Entity, Transform& t, const Kinematics& k, const WorldTransform& w) {
+			t.position += k.acceleration * w.scale;
+		});
+	});
+}
+
+// Same two-component view after half the entities were destroyed at random
+// and replaced, leaving dense arrays and chunks in scrambled entity order.
+void view2Fragmented(State& state, StorageMode mode, size_t count) {
+	EntityPool pool(count, mode);
+	std::vector<Entity> entities = populate(pool, count);
+	std::mt19937 rng(SEED);
+
+	std::shuffle(entities.begin(), entities.end(), rng);
+
+	for (size_t i = 0; i < count / 2; ++i)
+		pool.destroy(entities[i]);
+
+	populate(pool, count / 2);
+	iterateView2(state, pool);
+}
+
+void kinematicsSystem(State& state, StorageMode mode, size_t count) {
+	EntityPool pool(count, mode);
+	std::vector<Entity> entities = pool.createMany(count);
+	pool.addComponents(entities, Transform{}, Kinematics{});
+
+	Systems::KinematicsSystem system;
+	system.init(&pool);
+
+	state.setItemsPerIteration(count);
+	state.measure([&] {
+		system.fixedUpdate(&pool, FIXED_STEP);
+	});
+}
+
+template <typename Function>
+void addCase(Runner& runner, const char* name, Function function) {
+	for (StorageMode mode : STORAGE_MODES) {
+		for (size_t count : ENTITY_COUNTS) {
+			runner.add(name, storageName(mode), count, [function, mode, count](State& state) {
+				function(state, mode, count);
+			});
+		}
+	}
+}
+
+} // namespace
+
+void registerECSBenchmarks(Runner& runner) {
+	addCase(runner, "CreateDestroy", createDestroy);
+	addCase(runner, "AddRemove", addRemove);
+	addCase(runner, "View1", view1);
+	addCase(runner, "View2", view2);
+	addCase(runner, "View3", view3);
+	addCase(runner, "View2Fragmented", view2Fragmented);
+	addCase(runner, "KinematicsSystem", kinematicsSystem);
+}
+
+} // namespace Blackthorn::Benchmarks
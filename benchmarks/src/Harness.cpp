@@ -0,0 +1,177 @@
+#include "Harness.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <numeric>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::Benchmarks {
+
+namespace {
+
+std::string fullName(const std::string& name, const std::string& storage, size_t entities) {
+	return name + "/" + storage + "/" + std::to_string(entities);
+}
+
+std::string escape(const std::string& text) {
+	std::string escaped;
+
+	for (char c : text) {
+		if (c == '"' || c == '\\')
+			escaped += '\\';
+
+		escaped += c;
+	}
+
+	return escaped;
+}
+
+const char* valueOf(const char* argument, const char* option) {
+	size_t length = std::strlen(option);
+	return std::strncmp(argument, option, length) == 0 ? argument + length : nullptr;
+}
+
+} // namespace
+
+void Runner::add(std::string name, std::string storage, size_t entities, std::function<void(State&)> body) {
+	cases.push_back(Case{ std::move(name), std::move(storage), entities, std::move(body) });
+}
+
+bool Runner::parseArguments(int argc, char** argv) {
+	for (int i = 1; i < argc; ++i) {
+		const char* value = nullptr;
+
+		if ((value = valueOf(argv[i], "--filter="))) {
+			filter = value;
+		} else if ((value = valueOf(argv[i], "--json="))) {
+			jsonPath = value;
+		} else if ((value = valueOf(argv[i], "--min-time="))) {
+			minTime = std::strtod(value, nullptr);
+		} else if ((value = valueOf(argv[i], "--repetitions="))) {
+			repetitions = std::strtoul(value, nullptr, 10);
+		} else {
+			std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+			std::fprintf(stderr, "Usage: %s [--filter=<text>] [--min-time=<sec>] [--repetitions=<n>] [--json=<path>|-]\n", argv[0]);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+Result Runner::runCase(const Case& benchmark) const {
+	State state(minTime, repetitions);
+	benchmark.body(state);
+
+	Result result;
+	result.name = benchmark.name;
+	result.storage = benchmark.storage;
+	result.entities = benchmark.entities;
+	result.iterations = state.iterations;
+	result.repetitions = state.samples.size();
+
+	if (state.samples.empty())
+		return result;
+
+	std::vector<double> sorted = state.samples;
+	std::sort(sorted.begin(), sorted.end());
+
+	result.minNs = sorted.front();
+	result.medianNs = sorted[sorted.size() / 2];
+	result.meanNs = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+
+	if (state.items && result.medianNs > 0.0)
+		result.itemsPerSecond = static_cast<double>(state.items) * 1e9 / result.medianNs;
+
+	return result;
+}
+
+void Runner::printRow(const Result& result) const {
+	// Keep stdout clean for the JSON document when it goes there.
+	FILE* out = jsonPath == "-" ? stderr : stdout;
+
+	std::fprintf(out, "%-48s %14.1f ns %14.1f ns %12zu %14.3e items/s\n",
+		fullName(result.name, result.storage, result.entities).c_str(),
+		result.medianNs, result.minNs, result.iterations, result.itemsPerSecond);
+}
+
+bool Runner::writeJson() const {
+	FILE* out = jsonPath == "-" ? stdout : std::fopen(jsonPath.c_str(), "w");
+
+	if (!out) {
+		std::fprintf(stderr, "Could not open %s for writing\n", jsonPath.c_str());
+		return false;
+	}
+
+	char date[32] = {};
+	std::time_t now = std::time(nullptr);
+	std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+#if defined(BLACKTHORN_RELEASE)
+	const char* build = "Release";
+#elif defined(BLACKTHORN_DEBUG)
+	const char* build = "Debug";
+#else
+	const char* build = "Unknown";
+#endif
+
+	std::fprintf(out, "{\n");
+	std::fprintf(out, "  \"context\": {\n");
+	std::fprintf(out, "    \"date\": \"%s\",\n", date);
+	std::fprintf(out, "    \"build\": \"%s\",\n", build);
+	std::fprintf(out, "    \"max_components\": %zu,\n", ECS::Detail::MAX_COMPONENTS);
+	std::fprintf(out, "    \"min_time\": %g,\n", minTime);
+	std::fprintf(out, "    \"repetitions\": %zu\n", repetitions);
+	std::fprintf(out, "  },\n");
+	std::fprintf(out, "  \"benchmarks\": [");
+
+	for (size_t i = 0; i < results.size(); ++i) {
+		const Result& result = results[i];
+
+		std::fprintf(out, "%s\n    {\n", i ? "," : "");
+		std::fprintf(out, "      \"name\": \"%s\",\n", escape(fullName(result.name, result.storage, result.entities)).c_str());
+		std::fprintf(out, "      \"case\": \"%s\",\n", escape(result.name).c_str());
+		std::fprintf(out, "      \"storage\": \"%s\",\n", escape(result.storage).c_str());
+		std::fprintf(out, "      \"entities\": %zu,\n", result.entities);
+		std::fprintf(out, "      \"iterations\": %zu,\n", result.iterations);
+		std::fprintf(out, "      \"repetitions\": %zu,\n", result.repetitions);
+		std::fprintf(out, "      \"time_unit\": \"ns\",\n");
+		std::fprintf(out, "      \"min_time\": %.3f,\n", result.minNs);
+		std::fprintf(out, "      \"median_time\": %.3f,\n", result.medianNs);
+		std::fprintf(out, "      \"mean_time\": %.3f,\n", result.meanNs);
+		std::fprintf(out, "      \"items_per_second\": %.3f\n", result.itemsPerSecond);
+		std::fprintf(out, "    }");
+	}
+
+	std::fprintf(out, "\n  ]\n}\n");
+
+	if (out != stdout)
+		std::fclose(out);
+
+	return true;
+}
+
+int Runner::run(int argc, char** argv) {
+	if (!parseArguments(argc, argv))
+		return 1;
+
+	FILE* table = jsonPath == "-" ? stderr : stdout;
+	std::fprintf(table, "%-48s %17s %17s %12s %22s\n", "Benchmark", "Median", "Min", "Iterations", "Throughput");
+
+	for (const Case& benchmark : cases) {
+		if (!filter.empty() && fullName(benchmark.name, benchmark.storage, benchmark.entities).find(filter) == std::string::npos)
+			continue;
+
+		results.push_back(runCase(benchmark));
+		printRow(results.back());
+	}
+
+	if (!jsonPath.empty() && !writeJson())
+		return 1;
+
+	return 0;
+}
+
+} // namespace Blackthorn::Benchmarks
@@ -0,0 +1,7 @@
+#include "ECSBenchmarks.h"
+
+int main(int argc, char** argv) {
+	Blackthorn::Benchmarks::Runner runner;
+	Blackthorn::Benchmarks::registerECSBenchmarks(runner);
+	return runner.run(argc, argv);
+}
@@ -5,6 +5,7 @@
 #include "Assets/AssetManager.h"
 #include "Core/EngineConfig.h"
 #include "Core/Export.h"
+#include "Core/JobSystem.h"
 #include "Input/InputManager.h"
 #include "Graphics/Renderer.h"
 #include "Scene/SceneManager.h"
@@ -36,6 +37,7 @@ public:
 	Assets::AssetManager& getAssetManager() { return assetManager; }
 	Graphics::Renderer* getRenderer() const { return renderer.get(); }
 	Input::InputManager& getInputManager() { return inputManager; }
+	JobSystem& getJobSystem() { return jobSystem; }
 	Scene::SceneManager& getSceneManager() { return sceneManager; }
 	SDL_Window* getWindow() const { return window; }
 
@@ -49,6 +51,7 @@ private:
 	Assets::AssetManager assetManager;
 	std::unique_ptr<Graphics::Renderer> renderer;
 	Input::InputManager inputManager;
+	JobSystem jobSystem;
 	Scene::SceneManager sceneManager;
 	SDL_Window* window;
 	SDL_GLContext glContext;
@@ -32,6 +32,12 @@ struct BLACKTHORN_API TimingConfig {
 	int unfocusedFPS = 10;
 };
 
+struct BLACKTHORN_API JobConfig {
+	int workerCount = 0;
+	size_t grainSize = 256;
+	bool deterministic = false;
+};
+
 struct DebugConfig {
 	float profilingLogInterval = 1.0f;
 };
@@ -40,6 +46,7 @@ struct BLACKTHORN_API EngineConfig {
 	WindowConfig window;
 	RenderConfig render;
 	TimingConfig timing;
+	JobConfig jobs;
 	
 	DebugConfig  debug;
 };
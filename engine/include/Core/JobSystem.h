@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SDL3/SDL.h>
+
+#include "Core/Export.h"
+
+namespace Blackthorn {
+
+// Tracks one batch of submitted jobs. The first exception thrown by any of
+// them is kept here and rethrown by the wait() on this counter only.
+struct JobCounter {
+	std::atomic<size_t> pending{0};
+	std::mutex errorMutex;
+	std::exception_ptr error;
+};
+
+class BLACKTHORN_API JobSystem {
+public:
+	using Job = std::function<void()>;
+	using RangeJob = std::function<void(size_t begin, size_t end)>;
+
+	static constexpr size_t DEFAULT_GRAIN_SIZE = 256;
+
+	JobSystem() = default;
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// workerCount == 0 picks hardware_concurrency() - 1; the calling thread
+	// always takes part in wait() and parallelFor().
+	void init(Uint32 workerCount = 0);
+	void shutdown();
+
+	void submit(JobCounter& counter, Job job);
+	void wait(JobCounter& counter);
+
+	void parallelFor(size_t count, size_t grainSize, const RangeJob& job);
+
+	Uint32 getWorkerCount() const { return static_cast<Uint32>(workers.size()); }
+	Uint32 getThreadCount() const { return getWorkerCount() + 1; }
+
+	void setGrainSize(size_t grain) { grainSize = grain ? grain : 1; }
+	size_t getGrainSize() const { return grainSize; }
+
+	// Deterministic mode splits work purely by grain size, so range
+	// boundaries never depend on the worker count or timing.
+	void setDeterministic(bool enabled) { deterministic = enabled; }
+	bool isDeterministic() const { return deterministic; }
+
+	// 0 for the thread that called init(), 1..N for workers.
+	static Uint32 currentThreadIndex();
+
+private:
+	struct Task {
+		Job job;
+		JobCounter* counter = nullptr;
+	};
+
+	struct alignas(64) WorkQueue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::thread> workers;
+	std::vector<std::unique_ptr<WorkQueue>> queues;
+
+	std::mutex sleepMutex;
+	std::condition_variable wakeCondition;
+	std::atomic<size_t> queuedTasks{0};
+	std::atomic<bool> stopping{false};
+
+	size_t grainSize = DEFAULT_GRAIN_SIZE;
+	bool deterministic = false;
+
+	void workerLoop(Uint32 index);
+	bool popTask(Uint32 index, Task& task);
+	bool stealTask(Uint32 thief, Task& task);
+	void execute(Task& task);
+};
+
+} // namespace Blackthorn
@@ -1,15 +1,18 @@
 #pragma once
 
 #include <deque>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include <SDL3/SDL.h>
 
+#include "Core/Export.h"
+
 namespace Blackthorn::Debug {
 
-class Profiler {
+class BLACKTHORN_API Profiler {
 public:
 	struct Sample {
 		std::string name;
@@ -46,6 +49,8 @@ public:
 	void beginScope(const char* name);
 	void endScope(const char* name);
 
+	void recordSample(const char* name, Uint64 startTime, Uint64 endTime);
+
 	const std::vector<Sample>& getLastFrameSamples() const { return lastFrameSamples; }
 
 	ScopeStats getStats(const std::string& name, int frameCount = 60) const;
@@ -73,6 +78,9 @@ private:
 		int depth;
 	};
 
+	// Systems of worlds stepped in parallel record samples concurrently.
+	std::mutex mutex;
+
 	std::vector<ScopeEntry> scopeStack;
 	std::vector<Sample> currentFrameSamples;
 	std::vector<Sample> lastFrameSamples;
@@ -0,0 +1,762 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "ECS/Detail.h"
+#include "ECS/Snapshot.h"
+
+namespace Blackthorn::ECS {
+
+namespace Detail {
+
+constexpr size_t CHUNK_SIZE = 16 * 1024;
+constexpr size_t CHUNK_ALIGNMENT = 64;
+constexpr Uint32 NO_ARCHETYPE = UINT32_MAX;
+constexpr Uint16 NO_COLUMN = UINT16_MAX;
+
+struct ComponentInfo {
+	size_t size = 0;
+	size_t alignment = 0;
+	void (*moveConstruct)(void* dst, void* src) = nullptr;
+	void (*destroy)(void* ptr) = nullptr;
+	void (*save)(const void* src, size_t count, SnapshotWriter& writer) = nullptr;
+	void (*load)(void* dst, size_t count, SnapshotReader& reader) = nullptr;
+	void (*copyConstruct)(void* dst, const void* src, size_t count) = nullptr;
+	TypeHash hash = 0;
+	bool isTag = false;
+
+	template <typename T>
+	static ComponentInfo of() {
+		if constexpr (Detail::isTag<T>) {
+			ComponentInfo info;
+			info.hash = typeHash<T>;
+			info.isTag = true;
+			return info;
+		}
+
+		ComponentInfo info{
+			sizeof(T),
+			alignof(T),
+			[](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); },
+			[](void* ptr) { static_cast<T*>(ptr)->~T(); }
+		};
+
+		info.hash = typeHash<T>;
+
+		if constexpr (std::is_copy_constructible_v<T>) {
+			info.copyConstruct = [](void* dst, const void* src, size_t count) {
+				std::uninitialized_copy_n(static_cast<const T*>(src), count, static_cast<T*>(dst));
+			};
+		}
+
+		if constexpr (isSnapshotable<T>) {
+			info.save = [](const void* src, size_t count, SnapshotWriter& writer) { saveComponents(static_cast<const T*>(src), count, writer); };
+			info.load = [](void* dst, size_t count, SnapshotReader& reader) { loadComponents<T>(dst, count, reader); };
+		}
+
+		return info;
+	}
+};
+
+struct ChunkDeleter {
+	void operator()(std::byte* data) const {
+		::operator delete(data, std::align_val_t{CHUNK_ALIGNMENT});
+	}
+};
+
+// Change ticks are kept per chunk and column: the newest add/change of any
+// row in the chunk. Filters over them are conservative at chunk granularity.
+struct Chunk {
+	std::unique_ptr<std::byte, ChunkDeleter> data;
+	Uint32 count = 0;
+	std::vector<Uint32> addedTicks;
+	std::vector<Uint32> changedTicks;
+};
+
+struct EntityLocation {
+	Uint32 archetype = NO_ARCHETYPE;
+	Uint32 chunk = 0;
+	Uint32 row = 0;
+};
+
+inline size_t alignUp(size_t value, size_t alignment) noexcept {
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace Detail
+
+// Entities sharing one component mask, stored in fixed-size SoA chunks.
+// Every chunk but the last is full; rows stay packed through swap-removal.
+class Archetype {
+private:
+	Detail::ComponentMask mask;
+	Uint32 capacity = 0;
+	size_t chunkBytes = 0;
+	size_t entityCount = 0;
+
+	std::vector<Detail::ComponentInfo> columnInfos;
+	std::vector<size_t> columnOffsets;
+	std::array<Uint16, Detail::MAX_COMPONENTS> columnOf;
+	std::vector<Detail::Chunk> chunks;
+
+	friend class ArchetypeStorage;
+
+	size_t layoutBytes(Uint32 rows) {
+		size_t offset = sizeof(Entity) * rows;
+
+		for (size_t col = 0; col < columnInfos.size(); ++col) {
+			offset = Detail::alignUp(offset, columnInfos[col].alignment);
+			columnOffsets[col] = offset;
+			offset += columnInfos[col].size * rows;
+		}
+
+		return offset;
+	}
+
+	void* at(size_t chunk, Uint16 col, Uint32 row) {
+		return chunks[chunk].data.get() + columnOffsets[col] + columnInfos[col].size * row;
+	}
+
+	const void* at(size_t chunk, Uint16 col, Uint32 row) const {
+		return chunks[chunk].data.get() + columnOffsets[col] + columnInfos[col].size * row;
+	}
+
+	void appendChunk() {
+		Detail::Chunk chunk;
+		chunk.data.reset(static_cast<std::byte*>(
+			::operator new(chunkBytes, std::align_val_t{Detail::CHUNK_ALIGNMENT})
+		));
+		chunk.addedTicks.assign(columnInfos.size(), 0);
+		chunk.changedTicks.assign(columnInfos.size(), 0);
+		chunks.push_back(std::move(chunk));
+	}
+
+	Detail::EntityLocation pushRow(Uint32 self, Entity entity) {
+		if (chunks.empty() || chunks.back().count == capacity)
+			appendChunk();
+
+		Uint32 chunk = static_cast<Uint32>(chunks.size() - 1);
+		Uint32 row = chunks.back().count++;
+		entities(chunk)[row] = entity;
+		++entityCount;
+
+		return Detail::EntityLocation{self, chunk, row};
+	}
+
+	void mergeTicks(size_t chunk, Uint16 col, Uint32 added, Uint32 changed) {
+		Detail::Chunk& c = chunks[chunk];
+		c.addedTicks[col] = std::max(c.addedTicks[col], added);
+		c.changedTicks[col] = std::max(c.changedTicks[col], changed);
+	}
+
+public:
+	Archetype(const Detail::ComponentMask& componentMask, const std::array<Detail::ComponentInfo, Detail::MAX_COMPONENTS>& infos)
+		: mask(componentMask)
+	{
+		columnOf.fill(Detail::NO_COLUMN);
+
+		// Tags are part of the mask, so they still split archetypes, but get no column.
+		mask.forEach([&](size_t id) {
+			if (infos[id].isTag)
+				return;
+
+			assert(infos[id].alignment <= Detail::CHUNK_ALIGNMENT);
+			columnOf[id] = static_cast<Uint16>(columnInfos.size());
+			columnInfos.push_back(infos[id]);
+		});
+
+		columnOffsets.resize(columnInfos.size());
+
+		size_t rowBytes = sizeof(Entity);
+		for (const auto& info : columnInfos)
+			rowBytes += info.size;
+
+		capacity = static_cast<Uint32>(std::max<size_t>(Detail::CHUNK_SIZE / rowBytes, 1));
+		while (capacity > 1 && layoutBytes(capacity) > Detail::CHUNK_SIZE)
+			--capacity;
+
+		chunkBytes = Detail::alignUp(std::max(layoutBytes(capacity), Detail::CHUNK_SIZE), Detail::CHUNK_ALIGNMENT);
+	}
+
+	~Archetype() {
+		for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+			for (Uint16 col = 0; col < columnInfos.size(); ++col) {
+				for (Uint32 row = 0; row < chunks[chunk].count; ++row)
+					columnInfos[col].destroy(at(chunk, col, row));
+			}
+		}
+	}
+
+	Archetype(const Archetype&) = delete;
+	Archetype& operator=(const Archetype&) = delete;
+
+	// Same layout, so chunks copy one to one: the entity block and ticks as
+	// they are, each column in a single copy (a memcpy for trivial types).
+	std::unique_ptr<Archetype> clone(const std::array<Detail::ComponentInfo, Detail::MAX_COMPONENTS>& infos) const {
+		for (const auto& info : columnInfos) {
+			if (!info.copyConstruct)
+				throw std::runtime_error("Archetype: Component type is not copyable");
+		}
+
+		auto copy = std::make_unique<Archetype>(mask, infos);
+
+		for (size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+			const Detail::Chunk& source = chunks[chunk];
+			copy->appendChunk();
+
+			Detail::Chunk& target = copy->chunks.back();
+			std::memcpy(target.data.get(), source.data.get(), sizeof(Entity) * source.count);
+			target.addedTicks = source.addedTicks;
+			target.changedTicks = source.changedTicks;
+
+			for (Uint16 col = 0; col < columnInfos.size(); ++col) {
+				try {
+					columnInfos[col].copyConstruct(copy->at(chunk, col, 0), at(chunk, col, 0), source.count);
+				} catch (...) {
+					for (Uint16 built = 0; built < col; ++built) {
+						for (Uint32 row = 0; row < source.count; ++row)
+							columnInfos[built].destroy(copy->at(chunk, built, row));
+					}
+
+					copy->chunks.pop_back();
+					throw;
+				}
+			}
+
+			target.count = source.count;
+		}
+
+		copy->entityCount = entityCount;
+		return copy;
+	}
+
+	const Detail::ComponentMask& getMask() const { return mask; }
+	size_t size() const { return entityCount; }
+	Uint32 chunkCapacity() const { return capacity; }
+	size_t chunkCount() const { return chunks.size(); }
+	Uint32 chunkSize(size_t chunk) const { return chunks[chunk].count; }
+
+	bool hasComponent(size_t id) const {
+		return id < Detail::MAX_COMPONENTS && columnOf[id] != Detail::NO_COLUMN;
+	}
+
+	Entity* entities(size_t chunk) {
+		return reinterpret_cast<Entity*>(chunks[chunk].data.get());
+	}
+
+	Uint32 addedTick(size_t chunk, size_t id) const {
+		return chunks[chunk].addedTicks[columnOf[id]];
+	}
+
+	Uint32 changedTick(size_t chunk, size_t id) const {
+		return chunks[chunk].changedTicks[columnOf[id]];
+	}
+
+	void markChanged(size_t chunk, size_t id, Uint32 tick) {
+		chunks[chunk].changedTicks[columnOf[id]] = tick;
+	}
+
+	template <typename T>
+	T* column(size_t chunk) {
+		Uint16 col = columnOf[Detail::componentID<T>()];
+
+		if (col == Detail::NO_COLUMN)
+			return nullptr;
+
+		return reinterpret_cast<T*>(chunks[chunk].data.get() + columnOffsets[col]);
+	}
+};
+
+class ArchetypeStorage {
+private:
+	std::vector<std::unique_ptr<Archetype>> archetypes;
+	std::unordered_map<Detail::ComponentMask, Uint32, Detail::ComponentMask::Hash> archetypeLookup;
+	std::vector<Detail::EntityLocation> locations;
+	std::array<Detail::ComponentInfo, Detail::MAX_COMPONENTS> infos{};
+
+	Uint32 findOrCreate(const Detail::ComponentMask& mask) {
+		auto it = archetypeLookup.find(mask);
+		if (it != archetypeLookup.end())
+			return it->second;
+
+		Uint32 index = static_cast<Uint32>(archetypes.size());
+		archetypes.push_back(std::make_unique<Archetype>(mask, infos));
+		archetypeLookup.emplace(mask, index);
+		return index;
+	}
+
+	const Detail::EntityLocation* find(Entity entity, size_t id) const {
+		Uint32 idx = Detail::entityIndex(entity);
+
+		if (idx >= locations.size() || locations[idx].archetype == Detail::NO_ARCHETYPE)
+			return nullptr;
+
+		return archetypes[locations[idx].archetype]->hasComponent(id) ? &locations[idx] : nullptr;
+	}
+
+	Detail::EntityLocation& locationOf(Entity entity) {
+		Uint32 idx = Detail::entityIndex(entity);
+
+		if (idx >= locations.size())
+			locations.resize(idx + 1);
+
+		return locations[idx];
+	}
+
+	void eraseRow(const Detail::EntityLocation& loc) {
+		Archetype& arch = *archetypes[loc.archetype];
+
+		for (Uint16 col = 0; col < arch.columnInfos.size(); ++col)
+			arch.columnInfos[col].destroy(arch.at(loc.chunk, col, loc.row));
+
+		Uint32 lastChunk = static_cast<Uint32>(arch.chunks.size() - 1);
+		Uint32 lastRow = arch.chunks.back().count - 1;
+
+		if (loc.chunk != lastChunk || loc.row != lastRow) {
+			for (Uint16 col = 0; col < arch.columnInfos.size(); ++col) {
+				void* src = arch.at(lastChunk, col, lastRow);
+				arch.columnInfos[col].moveConstruct(arch.at(loc.chunk, col, loc.row), src);
+				arch.columnInfos[col].destroy(src);
+
+				const Detail::Chunk& last = arch.chunks[lastChunk];
+				arch.mergeTicks(loc.chunk, col, last.addedTicks[col], last.changedTicks[col]);
+			}
+
+			Entity moved = arch.entities(lastChunk)[lastRow];
+			arch.entities(loc.chunk)[loc.row] = moved;
+			locations[Detail::entityIndex(moved)] = loc;
+		}
+
+		if (--arch.chunks.back().count == 0)
+			arch.chunks.pop_back();
+
+		--arch.entityCount;
+	}
+
+	Detail::EntityLocation migrate(Entity entity, const Detail::ComponentMask& newMask) {
+		Detail::EntityLocation oldLoc = locationOf(entity);
+		Uint32 target = findOrCreate(newMask);
+		Detail::EntityLocation newLoc = archetypes[target]->pushRow(target, entity);
+
+		if (oldLoc.archetype != Detail::NO_ARCHETYPE) {
+			Archetype& from = *archetypes[oldLoc.archetype];
+			Archetype& to = *archetypes[newLoc.archetype];
+
+			(from.mask & to.mask).forEach([&](size_t id) {
+				Uint16 src = from.columnOf[id];
+				Uint16 dst = to.columnOf[id];
+
+				if (src == Detail::NO_COLUMN || dst == Detail::NO_COLUMN)
+					return;
+
+				from.columnInfos[src].moveConstruct(to.at(newLoc.chunk, dst, newLoc.row), from.at(oldLoc.chunk, src, oldLoc.row));
+
+				const Detail::Chunk& source = from.chunks[oldLoc.chunk];
+				to.mergeTicks(newLoc.chunk, dst, source.addedTicks[src], source.changedTicks[src]);
+			});
+
+			eraseRow(oldLoc);
+		}
+
+		locationOf(entity) = newLoc;
+		return newLoc;
+	}
+
+	Detail::ComponentMask maskOf(Entity entity) {
+		const Detail::EntityLocation& loc = locationOf(entity);
+		return loc.archetype != Detail::NO_ARCHETYPE ? archetypes[loc.archetype]->mask : Detail::ComponentMask{};
+	}
+
+	template <typename T, typename Value>
+	void place(const Detail::EntityLocation& loc, const Detail::ComponentMask& oldMask, Uint32 tick, Value&& value) {
+		if constexpr (Detail::isTag<T>)
+			return;
+
+		size_t id = Detail::componentID<T>();
+		Archetype& arch = *archetypes[loc.archetype];
+		Uint16 col = arch.columnOf[id];
+		void* dst = arch.at(loc.chunk, col, loc.row);
+
+		if (oldMask.test(id)) {
+			*static_cast<T*>(dst) = std::forward<Value>(value);
+			arch.markChanged(loc.chunk, id, tick);
+			return;
+		}
+
+		new (dst) T(std::forward<Value>(value));
+		arch.mergeTicks(loc.chunk, col, tick, tick);
+	}
+
+public:
+	ArchetypeStorage() = default;
+
+	template <typename T>
+	void registerComponent() {
+		size_t id = Detail::componentID<T>();
+
+		if (!infos[id].size && !infos[id].isTag)
+			infos[id] = Detail::ComponentInfo::of<T>();
+	}
+
+	template <typename T, typename... Args>
+	T& insert(Uint32 tick, Entity entity, Args&&... args) {
+		size_t id = Detail::componentID<T>();
+		registerComponent<T>();
+
+		Detail::EntityLocation loc = locationOf(entity);
+		Detail::ComponentMask mask = maskOf(entity);
+
+		if constexpr (Detail::isTag<T>) {
+			if (!mask.test(id))
+				migrate(entity, mask | Detail::ComponentMask::bit(id));
+
+			return Detail::tagInstance<T>();
+		}
+
+		if (mask.test(id)) {
+			Archetype& arch = *archetypes[loc.archetype];
+			T& component = *static_cast<T*>(arch.at(loc.chunk, arch.columnOf[id], loc.row));
+			component = T{ std::forward<Args>(args)... };
+			arch.markChanged(loc.chunk, id, tick);
+			return component;
+		}
+
+		loc = migrate(entity, mask | Detail::ComponentMask::bit(id));
+		Archetype& arch = *archetypes[loc.archetype];
+		arch.mergeTicks(loc.chunk, arch.columnOf[id], tick, tick);
+		return *new (arch.at(loc.chunk, arch.columnOf[id], loc.row)) T(std::forward<Args>(args)...);
+	}
+
+	// Places entities that have no components yet straight into the archetype
+	// for `mask`, a chunk at a time. `fill(id, memory, count)` constructs
+	// `count` consecutive components of type `id`.
+	template <typename Fill>
+	void spawn(Uint32 tick, std::span<const Entity> entities, const Detail::ComponentMask& mask, Fill&& fill) {
+		if (entities.empty() || mask.none())
+			return;
+
+		Uint32 target = findOrCreate(mask);
+		Archetype& arch = *archetypes[target];
+		size_t done = 0;
+
+		while (done < entities.size()) {
+			if (arch.chunks.empty() || arch.chunks.back().count == arch.capacity)
+				arch.appendChunk();
+
+			Uint32 chunk = static_cast<Uint32>(arch.chunks.size() - 1);
+			Uint32 begin = arch.chunks[chunk].count;
+			Uint32 rows = static_cast<Uint32>(std::min<size_t>(arch.capacity - begin, entities.size() - done));
+
+			for (size_t id = 0; id < Detail::MAX_COMPONENTS; ++id) {
+				Uint16 col = arch.columnOf[id];
+
+				if (col == Detail::NO_COLUMN)
+					continue;
+
+				try {
+					fill(id, arch.at(chunk, col, begin), rows);
+				} catch (...) {
+					for (Uint16 built = 0; built < col; ++built) {
+						for (Uint32 row = 0; row < rows; ++row)
+							arch.columnInfos[built].destroy(arch.at(chunk, built, begin + row));
+					}
+
+					if (arch.chunks[chunk].count == 0)
+						arch.chunks.pop_back();
+
+					throw;
+				}
+
+				arch.mergeTicks(chunk, col, tick, tick);
+			}
+
+			for (Uint32 row = 0; row < rows; ++row) {
+				Entity entity = entities[done + row];
+				arch.entities(chunk)[begin + row] = entity;
+				locationOf(entity) = Detail::EntityLocation{target, chunk, begin + row};
+			}
+
+			arch.chunks[chunk].count += rows;
+			arch.entityCount += rows;
+			done += rows;
+		}
+	}
+
+	// Adds copies of `values` to every entity with one archetype move each.
+	template <typename... Ts>
+	void insertMany(Uint32 tick, std::span<const Entity> entities, const Ts&... values) {
+		(registerComponent<Ts>(), ...);
+		Detail::ComponentMask added = (Detail::componentMask<Ts>() | ...);
+
+		bool fresh = std::all_of(entities.begin(), entities.end(), [this](Entity entity) { return maskOf(entity).none(); });
+
+		if (fresh) {
+			spawn(tick, entities, added, [&](size_t id, void* memory, size_t count) {
+				((id == Detail::componentID<Ts>() && (std::uninitialized_fill_n(static_cast<Ts*>(memory), count, values), true)) || ...);
+			});
+			return;
+		}
+
+		for (Entity entity : entities) {
+			Detail::ComponentMask mask = maskOf(entity);
+
+			if (!mask.contains(added))
+				migrate(entity, mask | added);
+
+			const Detail::EntityLocation& loc = locationOf(entity);
+			(place<Ts>(loc, mask, tick, values), ...);
+		}
+	}
+
+	// Moves values[i] into entities[i] (listed once each). `previous[i]` is
+	// the entity's mask before any extend() of this batch, so components it
+	// only gained a column for are constructed rather than assigned.
+	template <typename T>
+	void insertMany(Uint32 tick, std::span<const Entity> entities, std::span<T> values, std::span<const Detail::ComponentMask> previous) {
+		registerComponent<T>();
+		size_t id = Detail::componentID<T>();
+
+		for (size_t i = 0; i < entities.size(); ++i) {
+			Detail::ComponentMask mask = maskOf(entities[i]);
+
+			if (!mask.test(id))
+				migrate(entities[i], mask | Detail::ComponentMask::bit(id));
+
+			place<T>(locationOf(entities[i]), previous[i], tick, std::move(values[i]));
+		}
+	}
+
+	// Moves the entity to the archetype that also has `added` in one step,
+	// leaving the new columns unconstructed for the insertMany() calls that
+	// fill them. Lets a batch that adds several types move each entity once.
+	void extend(Entity entity, const Detail::ComponentMask& added) {
+		Detail::ComponentMask mask = maskOf(entity);
+
+		if (!mask.contains(added))
+			migrate(entity, mask | added);
+	}
+
+	void remove(Entity entity, size_t id) {
+		Detail::EntityLocation loc = locationOf(entity);
+
+		if (loc.archetype == Detail::NO_ARCHETYPE || !archetypes[loc.archetype]->mask.test(id))
+			return;
+
+		Detail::ComponentMask newMask = archetypes[loc.archetype]->mask;
+		newMask.reset(id);
+
+		if (newMask.none()) {
+			destroy(entity);
+			return;
+		}
+
+		migrate(entity, newMask);
+	}
+
+	void destroy(Entity entity) {
+		Detail::EntityLocation& loc = locationOf(entity);
+
+		if (loc.archetype == Detail::NO_ARCHETYPE)
+			return;
+
+		Detail::EntityLocation old = loc;
+		loc = Detail::EntityLocation{};
+		eraseRow(old);
+	}
+
+	template <typename T>
+	T* get(Entity entity) {
+		Uint32 idx = Detail::entityIndex(entity);
+
+		if (idx >= locations.size() || locations[idx].archetype == Detail::NO_ARCHETYPE)
+			return nullptr;
+
+		const Detail::EntityLocation& loc = locations[idx];
+		Archetype& arch = *archetypes[loc.archetype];
+		Uint16 col = arch.columnOf[Detail::componentID<T>()];
+
+		if (col == Detail::NO_COLUMN)
+			return nullptr;
+
+		return static_cast<T*>(arch.at(loc.chunk, col, loc.row));
+	}
+
+	Uint32 addedTick(Entity entity, size_t id) const {
+		const Detail::EntityLocation* loc = find(entity, id);
+		return loc ? archetypes[loc->archetype]->addedTick(loc->chunk, id) : 0;
+	}
+
+	Uint32 changedTick(Entity entity, size_t id) const {
+		const Detail::EntityLocation* loc = find(entity, id);
+		return loc ? archetypes[loc->archetype]->changedTick(loc->chunk, id) : 0;
+	}
+
+	void markChanged(Entity entity, size_t id, Uint32 tick) {
+		Uint32 idx = Detail::entityIndex(entity);
+
+		if (idx >= locations.size() || locations[idx].archetype == Detail::NO_ARCHETYPE)
+			return;
+
+		const Detail::EntityLocation& loc = locations[idx];
+		Archetype& arch = *archetypes[loc.archetype];
+
+		if (arch.hasComponent(id))
+			arch.markChanged(loc.chunk, id, tick);
+	}
+
+	void clear() {
+		archetypes.clear();
+		archetypeLookup.clear();
+		locations.clear();
+	}
+
+	ArchetypeStorage clone() const {
+		ArchetypeStorage copy;
+		copy.archetypeLookup = archetypeLookup;
+		copy.locations = locations;
+		copy.infos = infos;
+		copy.archetypes.reserve(archetypes.size());
+
+		for (const auto& archetype : archetypes)
+			copy.archetypes.push_back(archetype->clone(infos));
+
+		return copy;
+	}
+
+	// Same registered types, no entities; a restore loads into one of these
+	// and only swaps it in once the whole snapshot has been read.
+	ArchetypeStorage emptyClone() const {
+		ArchetypeStorage copy;
+		copy.infos = infos;
+		return copy;
+	}
+
+	// Per archetype: mask, row count and the type header of each column,
+	// then per chunk its row count, entity block and each column as one
+	// contiguous block.
+	void save(SnapshotWriter& writer) const {
+		Uint32 count = static_cast<Uint32>(std::count_if(archetypes.begin(), archetypes.end(), [](const auto& arch) { return arch->size() > 0; }));
+		writer.write(count);
+
+		for (const auto& archetype : archetypes) {
+			Archetype& arch = *archetype;
+
+			if (!arch.size())
+				continue;
+
+			writer.write(arch.mask);
+			writer.write(static_cast<Uint64>(arch.size()));
+
+			for (const auto& info : arch.columnInfos) {
+				if (!info.save)
+					Detail::missingSerializer();
+
+				Detail::writeTypeHeader(writer, info.hash, info.size);
+			}
+
+			for (size_t chunk = 0; chunk < arch.chunks.size(); ++chunk) {
+				const Detail::Chunk& c = arch.chunks[chunk];
+				writer.write(c.count);
+				writer.write(arch.entities(chunk), c.count * sizeof(Entity));
+
+				for (Uint16 col = 0; col < arch.columnInfos.size(); ++col)
+					arch.columnInfos[col].save(arch.at(chunk, col, 0), c.count, writer);
+			}
+		}
+	}
+
+	// Expects an empty storage. Masks are mapped to local ids and columns
+	// matched by type hash, since the saving process may have numbered the
+	// types differently. Loaded rows count as added and changed at `tick`.
+	void load(SnapshotReader& reader, const Detail::TypeRemap& remap, Uint32 tick) {
+		Uint32 count = reader.read<Uint32>();
+
+		for (Uint32 i = 0; i < count; ++i) {
+			auto mask = remap(reader.read<Detail::ComponentMask>());
+			size_t rows = reader.read<Uint64>();
+
+			mask.forEach([&](size_t id) {
+				if (infos[id].isTag)
+					return;
+
+				if (!infos[id].size)
+					throw std::runtime_error("Snapshot: Component type not registered with this pool");
+
+				if (!infos[id].load)
+					Detail::missingSerializer();
+			});
+
+			Uint32 index = findOrCreate(mask);
+			Archetype& arch = *archetypes[index];
+
+			// Saved column -> local column.
+			std::vector<Uint16> columns(arch.columnInfos.size());
+			Detail::ComponentMask seen;
+
+			for (Uint16& col : columns) {
+				TypeHash hash = reader.read<TypeHash>();
+				size_t size = reader.read<Uint64>();
+				size_t id = TypeRegistry::global().find(hash);
+
+				if (!arch.hasComponent(id) || seen.test(id) || infos[id].size != size)
+					Detail::layoutMismatch();
+
+				seen.set(id);
+				col = arch.columnOf[id];
+			}
+
+			while (rows > 0) {
+				Uint32 n = reader.read<Uint32>();
+
+				if (n == 0 || n > arch.capacity || n > rows)
+					Detail::layoutMismatch();
+
+				arch.appendChunk();
+
+				Uint32 chunk = static_cast<Uint32>(arch.chunks.size() - 1);
+				Detail::Chunk& c = arch.chunks.back();
+				std::fill(c.addedTicks.begin(), c.addedTicks.end(), tick);
+				std::fill(c.changedTicks.begin(), c.changedTicks.end(), tick);
+
+				reader.read(arch.entities(chunk), n * sizeof(Entity));
+
+				// Rows count as live only once every column is constructed, so a
+				// truncated snapshot never leaves half-built rows to destroy.
+				for (size_t saved = 0; saved < columns.size(); ++saved) {
+					try {
+						arch.columnInfos[columns[saved]].load(arch.at(chunk, columns[saved], 0), n, reader);
+					} catch (...) {
+						for (size_t built = 0; built < saved; ++built) {
+							for (Uint32 row = 0; row < n; ++row)
+								arch.columnInfos[columns[built]].destroy(arch.at(chunk, columns[built], row));
+						}
+
+						arch.chunks.pop_back();
+						throw;
+					}
+				}
+
+				c.count = n;
+				arch.entityCount += n;
+
+				Entity* chunkEntities = arch.entities(chunk);
+				for (Uint32 row = 0; row < n; ++row)
+					locationOf(chunkEntities[row]) = Detail::EntityLocation{index, chunk, row};
+
+				rows -= n;
+			}
+		}
+	}
+
+	const std::vector<std::unique_ptr<Archetype>>& getArchetypes() const { return archetypes; }
+};
+
+} // namespace Blackthorn::ECS
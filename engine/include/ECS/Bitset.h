@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+
+#include <SDL3/SDL.h>
+
+#if defined(__SSE4_1__)
+	#include <smmintrin.h>
+#endif
+
+namespace Blackthorn::ECS::Detail {
+
+// Fixed-width bit mask of `Words` 64-bit words. A single word compiles down
+// to plain integer operations; wider masks test containment and overlap 128
+// bits at a time when SSE4.1 is available.
+template <size_t Words>
+struct Bitset {
+	static_assert(Words > 0, "Bitset needs at least one word");
+
+	static constexpr size_t BITS = Words * 64;
+
+	std::array<Uint64, Words> words{};
+
+	struct Hash {
+		size_t operator()(const Bitset& bits) const noexcept {
+			Uint64 hash = 0xCBF29CE484222325ULL;
+
+			for (Uint64 word : bits.words)
+				hash = (hash ^ word) * 0x100000001B3ULL;
+
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	static Bitset bit(size_t index) {
+		Bitset bits;
+		bits.set(index);
+		return bits;
+	}
+
+	bool test(size_t index) const { return (words[index / 64] >> (index % 64)) & 1; }
+	void set(size_t index) { words[index / 64] |= 1ULL << (index % 64); }
+	void reset(size_t index) { words[index / 64] &= ~(1ULL << (index % 64)); }
+
+	bool any() const {
+		if constexpr (Words == 1) {
+			return words[0] != 0;
+		} else {
+			for (Uint64 word : words) {
+				if (word)
+					return true;
+			}
+
+			return false;
+		}
+	}
+
+	bool none() const { return !any(); }
+
+	// Every bit set in `other` is also set here.
+	bool contains(const Bitset& other) const {
+		if constexpr (Words == 1) {
+			return (words[0] & other.words[0]) == other.words[0];
+		}
+#if defined(__SSE4_1__)
+		else if constexpr (Words % 2 == 0) {
+			for (size_t i = 0; i < Words; i += 2) {
+				__m128i mine = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words.data() + i));
+				__m128i theirs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other.words.data() + i));
+
+				if (!_mm_testc_si128(mine, theirs))
+					return false;
+			}
+
+			return true;
+		}
+#endif
+		else {
+			for (size_t i = 0; i < Words; ++i) {
+				if ((words[i] & other.words[i]) != other.words[i])
+					return false;
+			}
+
+			return true;
+		}
+	}
+
+	bool intersects(const Bitset& other) const {
+		if constexpr (Words == 1) {
+			return (words[0] & other.words[0]) != 0;
+		}
+#if defined(__SSE4_1__)
+		else if constexpr (Words % 2 == 0) {
+			for (size_t i = 0; i < Words; i += 2) {
+				__m128i mine = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words.data() + i));
+				__m128i theirs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(other.words.data() + i));
+
+				if (!_mm_testz_si128(mine, theirs))
+					return true;
+			}
+
+			return false;
+		}
+#endif
+		else {
+			for (size_t i = 0; i < Words; ++i) {
+				if (words[i] & other.words[i])
+					return true;
+			}
+
+			return false;
+		}
+	}
+
+	// Calls `function(index)` for every set bit, lowest first.
+	template <typename Function>
+	void forEach(Function&& function) const {
+		for (size_t i = 0; i < Words; ++i) {
+			for (Uint64 word = words[i]; word; word &= word - 1)
+				function(i * 64 + static_cast<size_t>(std::countr_zero(word)));
+		}
+	}
+
+	Bitset& operator|=(const Bitset& other) {
+		for (size_t i = 0; i < Words; ++i)
+			words[i] |= other.words[i];
+
+		return *this;
+	}
+
+	Bitset& operator&=(const Bitset& other) {
+		for (size_t i = 0; i < Words; ++i)
+			words[i] &= other.words[i];
+
+		return *this;
+	}
+
+	friend Bitset operator|(Bitset lhs, const Bitset& rhs) { return lhs |= rhs; }
+	friend Bitset operator&(Bitset lhs, const Bitset& rhs) { return lhs &= rhs; }
+
+	Bitset operator~() const {
+		Bitset result;
+
+		for (size_t i = 0; i < Words; ++i)
+			result.words[i] = ~words[i];
+
+		return result;
+	}
+
+	bool operator==(const Bitset&) const = default;
+};
+
+} // namespace Blackthorn::ECS::Detail
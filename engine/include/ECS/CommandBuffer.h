@@ -0,0 +1,285 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::ECS {
+
+class EntityPool;
+
+struct PendingEntity {
+	Uint32 index = INVALID_ENTITY;
+};
+
+namespace Detail {
+
+struct CommandTarget {
+	Entity entity = INVALID_ENTITY;
+	Uint32 pending = INVALID_ENTITY;
+
+	Entity resolve(const std::vector<Entity>& created) const {
+		return pending != INVALID_ENTITY ? created[pending] : entity;
+	}
+
+	// Distinguishes pending entities from live ones with the same value.
+	Uint64 key() const {
+		return pending != INVALID_ENTITY ? (static_cast<Uint64>(1) << 32) | pending : entity;
+	}
+};
+
+class ICommandQueue {
+public:
+	virtual ~ICommandQueue() = default;
+	virtual size_t component() const = 0;
+
+	// Settles the surviving inserts on one value per live target, whose
+	// entities insertTargets() then lists, and applyInserts() moves in.
+	virtual void resolveInserts(EntityPool& pool, const std::vector<Entity>& created) = 0;
+	virtual std::span<const Entity> insertTargets() const = 0;
+	virtual void applyInserts(EntityPool& pool) = 0;
+
+	virtual void applyRemoves(EntityPool& pool, const std::vector<Entity>& created) = 0;
+	virtual void clear() = 0;
+};
+
+// Inserts and removes are applied in two bulk passes, so each command keeps
+// its recording sequence. When one target has both, only the commands
+// after its last opposite command survive: the last recorded one wins, and
+// of several inserts on one target the last one's value is kept.
+template <typename T>
+class CommandQueue : public ICommandQueue {
+private:
+	struct Insert {
+		CommandTarget target;
+		Uint32 sequence;
+		T component;
+	};
+
+	struct Remove {
+		CommandTarget target;
+		Uint32 sequence;
+	};
+
+	std::vector<bool> insertSkipped;
+	std::vector<bool> removeSkipped;
+	std::vector<Entity> resolvedTargets;
+	std::vector<T> resolvedValues;
+
+	void resolveOrder() {
+		insertSkipped.assign(inserts.size(), false);
+		removeSkipped.assign(removes.size(), false);
+
+		if (inserts.empty() || removes.empty())
+			return;
+
+		std::unordered_map<Uint64, Uint32> lastInsert;
+		std::unordered_map<Uint64, Uint32> lastRemove;
+
+		for (const Insert& insert : inserts)
+			lastInsert[insert.target.key()] = insert.sequence;
+
+		for (const Remove& remove : removes)
+			lastRemove[remove.target.key()] = remove.sequence;
+
+		for (size_t i = 0; i < inserts.size(); ++i) {
+			auto it = lastRemove.find(inserts[i].target.key());
+			insertSkipped[i] = it != lastRemove.end() && it->second > inserts[i].sequence;
+		}
+
+		for (size_t i = 0; i < removes.size(); ++i) {
+			auto it = lastInsert.find(removes[i].target.key());
+			removeSkipped[i] = it != lastInsert.end() && it->second > removes[i].sequence;
+		}
+	}
+
+	template <typename Pool>
+	void resolveAll(Pool& pool, const std::vector<Entity>& created) {
+		resolveOrder();
+		resolvedTargets.clear();
+		resolvedValues.clear();
+
+		if (inserts.empty())
+			return;
+
+		pool.template registerComponent<T>();
+		resolvedTargets.reserve(inserts.size());
+		resolvedValues.reserve(inserts.size());
+
+		std::unordered_map<Entity, size_t> slots;
+
+		for (size_t i = 0; i < inserts.size(); ++i) {
+			if (insertSkipped[i])
+				continue;
+
+			Entity entity = inserts[i].target.resolve(created);
+
+			if (!pool.isValid(entity))
+				continue;
+
+			auto [slot, fresh] = slots.try_emplace(entity, resolvedTargets.size());
+
+			if (!fresh) {
+				resolvedValues[slot->second] = std::move(inserts[i].component);
+				continue;
+			}
+
+			resolvedTargets.push_back(entity);
+			resolvedValues.push_back(std::move(inserts[i].component));
+		}
+	}
+
+	template <typename Pool>
+	void insertAll(Pool& pool) {
+		if (!resolvedTargets.empty())
+			pool.template insertResolved<T>(resolvedTargets, std::span<T>(resolvedValues));
+	}
+
+	template <typename Pool>
+	void removeAll(Pool& pool, const std::vector<Entity>& created) {
+		for (size_t i = 0; i < removes.size(); ++i) {
+			if (!removeSkipped[i])
+				pool.template removeComponent<T>(removes[i].target.resolve(created));
+		}
+	}
+
+public:
+	std::vector<Insert> inserts;
+	std::vector<Remove> removes;
+	Uint32 sequence = 0;
+
+	template <typename... Args>
+	void insert(CommandTarget target, Args&&... args) {
+		inserts.push_back(Insert{ target, sequence++, T(std::forward<Args>(args)...) });
+	}
+
+	void remove(CommandTarget target) {
+		removes.push_back(Remove{ target, sequence++ });
+	}
+
+	size_t component() const override {
+		return componentID<T>();
+	}
+
+	void resolveInserts(EntityPool& pool, const std::vector<Entity>& created) override {
+		resolveAll(pool, created);
+	}
+
+	std::span<const Entity> insertTargets() const override {
+		return resolvedTargets;
+	}
+
+	void applyInserts(EntityPool& pool) override {
+		insertAll(pool);
+	}
+
+	void applyRemoves(EntityPool& pool, const std::vector<Entity>& created) override {
+		removeAll(pool, created);
+	}
+
+	void clear() override {
+		inserts.clear();
+		removes.clear();
+		resolvedTargets.clear();
+		resolvedValues.clear();
+		sequence = 0;
+	}
+};
+
+} // namespace Detail
+
+// Records structural changes for later playback by EntityPool. Commands are
+// applied in bulk: creations, then per-component inserts, then per-component
+// removals, then destructions. Adding and removing the same component on one
+// entity resolves to whichever was recorded last.
+class CommandBuffer {
+private:
+	std::array<std::unique_ptr<Detail::ICommandQueue>, Detail::MAX_COMPONENTS> queues;
+	std::vector<Detail::CommandTarget> destroys;
+	std::vector<Entity> created;
+	Uint32 pendingCount = 0;
+	bool recorded = false;
+
+	friend class EntityPool;
+
+	template <typename Component>
+	Detail::CommandQueue<Component>& queue() {
+		size_t id = Detail::componentID<Component>();
+
+		if (!queues[id])
+			queues[id] = std::make_unique<Detail::CommandQueue<Component>>();
+
+		recorded = true;
+		return static_cast<Detail::CommandQueue<Component>&>(*queues[id]);
+	}
+
+	void swap(CommandBuffer& other) noexcept {
+		queues.swap(other.queues);
+		destroys.swap(other.destroys);
+		created.swap(other.created);
+		std::swap(pendingCount, other.pendingCount);
+		std::swap(recorded, other.recorded);
+	}
+
+public:
+	CommandBuffer() = default;
+
+	CommandBuffer(const CommandBuffer&) = delete;
+	CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+	PendingEntity create() {
+		recorded = true;
+		return PendingEntity{pendingCount++};
+	}
+
+	void destroy(Entity entity) {
+		recorded = true;
+		destroys.push_back(Detail::CommandTarget{entity, INVALID_ENTITY});
+	}
+
+	void destroy(PendingEntity entity) {
+		recorded = true;
+		destroys.push_back(Detail::CommandTarget{INVALID_ENTITY, entity.index});
+	}
+
+	template <typename Component, typename... Args>
+	void add(Entity entity, Args&&... args) {
+		queue<Component>().insert(Detail::CommandTarget{entity, INVALID_ENTITY}, std::forward<Args>(args)...);
+	}
+
+	template <typename Component, typename... Args>
+	void add(PendingEntity entity, Args&&... args) {
+		queue<Component>().insert(Detail::CommandTarget{INVALID_ENTITY, entity.index}, std::forward<Args>(args)...);
+	}
+
+	template <typename Component>
+	void remove(Entity entity) {
+		queue<Component>().remove(Detail::CommandTarget{entity, INVALID_ENTITY});
+	}
+
+	template <typename Component>
+	void remove(PendingEntity entity) {
+		queue<Component>().remove(Detail::CommandTarget{INVALID_ENTITY, entity.index});
+	}
+
+	bool empty() const { return !recorded; }
+
+	void clear() {
+		for (auto& q : queues) {
+			if (q)
+				q->clear();
+		}
+
+		destroys.clear();
+		created.clear();
+		pendingCount = 0;
+		recorded = false;
+	}
+};
+
+} // namespace Blackthorn::ECS
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
 #include "ECS/Detail.h"
 #include "ECS/IComponentArray.h"
 
@@ -10,35 +16,132 @@ class ComponentArray : public IComponentArray {
 private:
 	std::vector<T> components;
 	std::vector<Entity> dense;
-	std::vector<Uint32> sparse;
+	std::vector<Uint32> addedTicks;
+	std::vector<Uint32> changedTicks;
+	std::vector<std::unique_ptr<Uint32[]>> sparsePages;
+
+	Uint32 sparseAt(Entity entity) const {
+		Uint32 idx = Detail::entityIndex(entity);
+		size_t page = idx / Detail::SPARSE_PAGE_SIZE;
+
+		if (page >= sparsePages.size() || !sparsePages[page])
+			return INVALID_ENTITY;
+
+		return sparsePages[page][idx % Detail::SPARSE_PAGE_SIZE];
+	}
+
+	Uint32& assureSparse(Entity entity) {
+		Uint32 idx = Detail::entityIndex(entity);
+		size_t page = idx / Detail::SPARSE_PAGE_SIZE;
+
+		if (page >= sparsePages.size())
+			sparsePages.resize(page + 1);
+
+		if (!sparsePages[page]) {
+			sparsePages[page] = std::make_unique<Uint32[]>(Detail::SPARSE_PAGE_SIZE);
+			std::fill_n(sparsePages[page].get(), Detail::SPARSE_PAGE_SIZE, INVALID_ENTITY);
+		}
+
+		return sparsePages[page][idx % Detail::SPARSE_PAGE_SIZE];
+	}
 
 public:
-	explicit ComponentArray(size_t reserve = Detail::MAX_ENTITIES) {
+	explicit ComponentArray(size_t reserve = 0) {
 		components.reserve(reserve);
 		dense.reserve(reserve);
-		sparse.assign(reserve, INVALID_ENTITY);
+		addedTicks.reserve(reserve);
+		changedTicks.reserve(reserve);
+	}
+
+	void reserve(size_t additional) {
+		components.reserve(components.size() + additional);
+		dense.reserve(dense.size() + additional);
+		addedTicks.reserve(addedTicks.size() + additional);
+		changedTicks.reserve(changedTicks.size() + additional);
 	}
 
 	template <typename... Args>
-	T& insert(Entity entity, Args&&... args) {
-		Uint32 idx = Detail::entityIndex(entity);
-		Uint32 pos = sparse[idx];
+	T& insert(Uint32 tick, Entity entity, Args&&... args) {
+		Uint32& pos = assureSparse(entity);
 
 		if (pos != INVALID_ENTITY && dense[pos] == entity) {
 			components[pos] = T{ std::forward<Args>(args)... };
+			changedTicks[pos] = tick;
 			return components[pos];
 		}
 
 		pos = static_cast<Uint32>(components.size());
 		components.emplace_back(std::forward<Args>(args)...);
 		dense.push_back(entity);
-		sparse[idx] = pos;
+		addedTicks.push_back(tick);
+		changedTicks.push_back(tick);
 		return components.back();
 	}
 
+	// Gives every entity a copy of `value`. Entities that already have the
+	// component are overwritten; the rest are appended in one contiguous fill.
+	void insertMany(Uint32 tick, std::span<const Entity> entities, const T& value) {
+		reserve(entities.size());
+		size_t first = components.size();
+
+		for (Entity entity : entities) {
+			Uint32& pos = assureSparse(entity);
+
+			if (pos != INVALID_ENTITY && dense[pos] == entity) {
+				if (pos < first) {
+					components[pos] = value;
+					changedTicks[pos] = tick;
+				}
+
+				continue;
+			}
+
+			pos = static_cast<Uint32>(dense.size());
+			dense.push_back(entity);
+		}
+
+		size_t added = dense.size() - first;
+
+		try {
+			components.insert(components.end(), added, value);
+			addedTicks.insert(addedTicks.end(), added, tick);
+			changedTicks.insert(changedTicks.end(), added, tick);
+		} catch (...) {
+			for (size_t i = first; i < dense.size(); ++i)
+				assureSparse(dense[i]) = INVALID_ENTITY;
+
+			components.erase(components.begin() + std::min(first, components.size()), components.end());
+			dense.resize(first);
+			addedTicks.resize(first);
+			changedTicks.resize(first);
+			throw;
+		}
+	}
+
+	// Moves values[i] into entities[i]; each entity is listed once.
+	void insertMany(Uint32 tick, std::span<const Entity> entities, std::span<T> values) {
+		reserve(entities.size());
+
+		for (size_t i = 0; i < entities.size(); ++i) {
+			Uint32& pos = assureSparse(entities[i]);
+
+			if (pos != INVALID_ENTITY && dense[pos] == entities[i]) {
+				components[pos] = std::move(values[i]);
+				changedTicks[pos] = tick;
+				continue;
+			}
+
+			// Capacity is reserved, so only the component move can throw.
+			components.push_back(std::move(values[i]));
+			dense.push_back(entities[i]);
+			addedTicks.push_back(tick);
+			changedTicks.push_back(tick);
+			pos = static_cast<Uint32>(dense.size() - 1);
+		}
+	}
+
 	void remove(Entity entity) override {
-		Uint32 idx = Detail::entityIndex(entity);
-		Uint32 pos = sparse[idx];
+		Uint32 pos = sparseAt(entity);
 
 		if (pos == INVALID_ENTITY || dense[pos] != entity)
 			return;
@@ -47,23 +150,25 @@ public:
 		if (pos != lastPos) {
 			components[pos] = std::move(components[lastPos]);
 			dense[pos] = dense[lastPos];
-			sparse[Detail::entityIndex(dense[pos])] = pos;
+			addedTicks[pos] = addedTicks[lastPos];
+			changedTicks[pos] = changedTicks[lastPos];
+			assureSparse(dense[pos]) = pos;
 		}
 
 		components.pop_back();
 		dense.pop_back();
-		sparse[idx] = INVALID_ENTITY;
+		addedTicks.pop_back();
+		changedTicks.pop_back();
+		assureSparse(entity) = INVALID_ENTITY;
 	}
 
 	bool has(Entity entity) const override {
-		Uint32 idx = Detail::entityIndex(entity);
-		Uint32 pos = sparse[idx];
+		Uint32 pos = sparseAt(entity);
 		return pos != INVALID_ENTITY && dense[pos] == entity;
 	}
 
 	T* get(Entity entity) {
-		Uint32 idx = Detail::entityIndex(entity);
-		Uint32 pos = sparse[idx];
+		Uint32 pos = sparseAt(entity);
 
 		if (pos == INVALID_ENTITY || dense[pos] != entity)
 			return nullptr;
@@ -72,8 +177,7 @@ public:
 	}
 
 	const T* get(Entity entity) const {
-		Uint32 idx = Detail::entityIndex(entity);
-		Uint32 pos = sparse[idx];
+		Uint32 pos = sparseAt(entity);
 
 		if (pos == INVALID_ENTITY || dense[pos] != entity)
 			return nullptr;
@@ -81,9 +185,146 @@ public:
 		return &components[pos];
 	}
 
+	// Like get(), but marks the component changed at `tick`.
+	T* getMut(Entity entity, Uint32 tick) {
+		Uint32 pos = sparseAt(entity);
+
+		if (pos == INVALID_ENTITY || dense[pos] != entity)
+			return nullptr;
+
+		changedTicks[pos] = tick;
+		return &components[pos];
+	}
+
+	void markChanged(Entity entity, Uint32 tick) {
+		Uint32 pos = indexOf(entity);
+
+		if (pos != INVALID_ENTITY)
+			changedTicks[pos] = tick;
+	}
+
+	Uint32 addedTick(Entity entity) const {
+		Uint32 pos = indexOf(entity);
+		return pos != INVALID_ENTITY ? addedTicks[pos] : 0;
+	}
+
+	Uint32 changedTick(Entity entity) const {
+		Uint32 pos = indexOf(entity);
+		return pos != INVALID_ENTITY ? changedTicks[pos] : 0;
+	}
+
+	Uint32 indexOf(Entity entity) const override {
+		Uint32 pos = sparseAt(entity);
+		return pos != INVALID_ENTITY && dense[pos] == entity ? pos : INVALID_ENTITY;
+	}
+
+	void swapEntries(Uint32 a, Uint32 b) override {
+		if (a == b)
+			return;
+
+		std::swap(components[a], components[b]);
+		std::swap(dense[a], dense[b]);
+		std::swap(addedTicks[a], addedTicks[b]);
+		std::swap(changedTicks[a], changedTicks[b]);
+		assureSparse(dense[a]) = a;
+		assureSparse(dense[b]) = b;
+	}
+
+	void clear() override {
+		for (Entity entity : dense)
+			assureSparse(entity) = INVALID_ENTITY;
+
+		components.clear();
+		dense.clear();
+		addedTicks.clear();
+		changedTicks.clear();
+	}
+
+	// Dense arrays copy as whole vectors, a memcpy for trivially copyable
+	// components; only the sparse pages in use are duplicated.
+	std::unique_ptr<IComponentArray> clone() const override {
+		if constexpr (std::is_copy_constructible_v<T>) {
+			auto copy = std::make_unique<ComponentArray<T>>();
+			copy->components = components;
+			copy->dense = dense;
+			copy->addedTicks = addedTicks;
+			copy->changedTicks = changedTicks;
+			copy->sparsePages.resize(sparsePages.size());
+
+			for (size_t page = 0; page < sparsePages.size(); ++page) {
+				if (!sparsePages[page])
+					continue;
+
+				copy->sparsePages[page] = std::make_unique<Uint32[]>(Detail::SPARSE_PAGE_SIZE);
+				std::copy_n(sparsePages[page].get(), Detail::SPARSE_PAGE_SIZE, copy->sparsePages[page].get());
+			}
+
+			return copy;
+		} else {
+			throw std::runtime_error("ComponentArray: Component type is not copyable");
+		}
+	}
+
+	std::unique_ptr<IComponentArray> create() const override {
+		return std::make_unique<ComponentArray<T>>();
+	}
+
+	// Ticks aren't saved: a restore stamps every row with a fresh tick.
+	void save(SnapshotWriter& writer) const override {
+		Detail::writeTypeHeader(writer, Detail::typeHash<T>, sizeof(T));
+		writer.write(static_cast<Uint64>(dense.size()));
+		writer.write(dense.data(), dense.size() * sizeof(Entity));
+		Detail::saveComponents(components.data(), components.size(), writer);
+	}
+
+	void load(SnapshotReader& reader, Uint32 tick) override {
+		clear();
+
+		try {
+			Detail::checkTypeHeader(reader, Detail::typeHash<T>, sizeof(T));
+
+			size_t count = reader.readCount(sizeof(Entity));
+			dense.resize(count);
+			addedTicks.assign(count, tick);
+			changedTicks.assign(count, tick);
+			reader.read(dense.data(), count * sizeof(Entity));
+
+			if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && !Detail::HasSerializer<T>) {
+				components.resize(count);
+				reader.read(components.data(), count * sizeof(T));
+			} else {
+				components.reserve(count);
+
+				for (size_t i = 0; i < count; ++i) {
+					alignas(T) std::byte raw[sizeof(T)];
+					Detail::loadComponents<T>(raw, 1, reader);
+
+					T* loaded = std::launder(reinterpret_cast<T*>(raw));
+					components.push_back(std::move(*loaded));
+					loaded->~T();
+				}
+			}
+
+			for (Uint32 i = 0; i < count; ++i)
+				assureSparse(dense[i]) = i;
+		} catch (...) {
+			components.clear();
+			dense.clear();
+			addedTicks.clear();
+			changedTicks.clear();
+			throw;
+		}
+	}
+
 	size_t size() const override { return components.size(); }
 	const std::vector<Entity>& entities() const override { return dense; }
 
+	T* data() { return components.data(); }
+	const T* data() const { return components.data(); }
+
+	Uint32* addedTickData() { return addedTicks.data(); }
+	Uint32* changedTickData() { return changedTicks.data(); }
+
 	T& getByIndex(size_t i) { return components[i]; }
 	const T& getByIndex(size_t i) const { return components[i]; }
 };
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Core/Export.h"
+
+namespace Blackthorn::ECS::Components {
+
+// Axis-aligned box relative to the entity's position, scaled with it.
+struct BLACKTHORN_API Bounds {
+	glm::vec2 size{64, 64};
+	glm::vec2 offset{0, 0};
+
+	BLACKTHORN_API Bounds() = default;
+	BLACKTHORN_API Bounds(float w, float h) : size(w, h) {}
+	BLACKTHORN_API Bounds(glm::vec2 boxSize, glm::vec2 boxOffset = {0, 0}) : size(boxSize), offset(boxOffset) {}
+};
+
+} // namespace Blackthorn::ECS::Components
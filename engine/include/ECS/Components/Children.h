@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+#include "Core/Export.h"
+#include "ECS/Entity.h"
+#include "ECS/Snapshot.h"
+
+namespace Blackthorn::ECS::Components {
+
+struct BLACKTHORN_API Children {
+	std::vector<Entity> entities;
+
+	BLACKTHORN_API Children() = default;
+};
+
+} // namespace Blackthorn::ECS::Components
+
+namespace Blackthorn::ECS {
+
+template <>
+struct Serializer<Components::Children> {
+	static void save(const Components::Children& children, SnapshotWriter& writer) {
+		writer.write(static_cast<Uint32>(children.entities.size()));
+		writer.write(children.entities.data(), children.entities.size() * sizeof(Entity));
+	}
+
+	static Components::Children load(SnapshotReader& reader) {
+		Components::Children children;
+		children.entities.resize(reader.read<Uint32>());
+		reader.read(children.entities.data(), children.entities.size() * sizeof(Entity));
+		return children;
+	}
+};
+
+} // namespace Blackthorn::ECS
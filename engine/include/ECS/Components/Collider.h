@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <glm/glm.hpp>
+
+#include "Core/Export.h"
+
+namespace Blackthorn::ECS::Components {
+
+// Collision shape centered on the entity's position plus `offset`, scaled
+// with it. Oriented boxes and the offset turn with the entity's angle; AABBs
+// never rotate. Entities with Kinematics are pushed out of contacts,
+// everything else is static. Triggers report contacts without resolving.
+struct BLACKTHORN_API Collider {
+	enum class Shape : Uint8 {
+		AABB,
+		Circle,
+		OBB
+	};
+
+	Shape shape = Shape::AABB;
+	glm::vec2 halfExtents{32, 32};
+	float radius = 32.0f;
+	glm::vec2 offset{0, 0};
+	Uint32 layer = 1;
+	Uint32 mask = UINT32_MAX;
+	bool isTrigger = false;
+
+	BLACKTHORN_API Collider() = default;
+
+	static Collider box(float halfWidth, float halfHeight, bool oriented = false) {
+		Collider collider;
+		collider.shape = oriented ? Shape::OBB : Shape::AABB;
+		collider.halfExtents = { halfWidth, halfHeight };
+		return collider;
+	}
+
+	static Collider circle(float circleRadius) {
+		Collider collider;
+		collider.shape = Shape::Circle;
+		collider.radius = circleRadius;
+		return collider;
+	}
+};
+
+} // namespace Blackthorn::ECS::Components
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Core/Export.h"
+#include "ECS/Entity.h"
+
+namespace Blackthorn::ECS::Components {
+
+struct BLACKTHORN_API Parent {
+	Entity entity = INVALID_ENTITY;
+
+	BLACKTHORN_API Parent() = default;
+	BLACKTHORN_API Parent(Entity parent) : entity(parent) {}
+};
+
+} // namespace Blackthorn::ECS::Components
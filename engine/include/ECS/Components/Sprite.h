@@ -11,6 +11,8 @@ struct BLACKTHORN_API Sprite {
 	SDL_FRect dest{0, 0, 64, 64};
 	Graphics::Texture* texture = nullptr;
 
+	// Draw order: by layer, then zOrder, lowest first.
+	Uint8 layer = 0;
 	float zOrder = 0.0f;
 	
 	bool flipX = false;
@@ -1,16 +1,46 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 #include "Core/Export.h"
+#include "ECS/Snapshot.h"
+#include "Utils/StringInterner.h"
 
 namespace Blackthorn::ECS::Components {
 
+// Name interned in the global StringInterner; the component itself is just
+// the symbol, so it is trivially copyable and compares in one instruction.
 struct BLACKTHORN_API Tag {
-	std::string name;
+	Utils::Symbol symbol = Utils::EMPTY_SYMBOL;
 
 	BLACKTHORN_API Tag() = default;
-	BLACKTHORN_API Tag(const std::string& tag) : name(tag) {}
+	BLACKTHORN_API Tag(std::string_view tag) : symbol(Utils::StringInterner::global().intern(tag)) {}
+
+	std::string_view name() const { return Utils::StringInterner::global().resolve(symbol); }
+
+	bool operator==(const Tag&) const = default;
+};
+
+} // namespace Blackthorn::ECS::Components
+
+namespace Blackthorn::ECS {
+
+// Symbols are numbered per process, so snapshots store the name and intern
+// it again on load.
+template <>
+struct Serializer<Components::Tag> {
+	static void save(const Components::Tag& tag, SnapshotWriter& writer) {
+		std::string_view name = tag.name();
+		writer.write(static_cast<Uint64>(name.size()));
+		writer.write(name.data(), name.size());
+	}
+
+	static Components::Tag load(SnapshotReader& reader) {
+		std::string name(reader.readCount(1), '\0');
+		reader.read(name.data(), name.size());
+		return Components::Tag(name);
+	}
 };
 
-} // namespace Blackthorn::ECS::Components
\ No newline at end of file
+} // namespace Blackthorn::ECS
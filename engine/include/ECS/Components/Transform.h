@@ -16,4 +16,7 @@ struct BLACKTHORN_API Transform {
 	BLACKTHORN_API Transform(glm::vec2 pos) : position(pos) {} 
 };
 
+// Transform is relative to the entity's Parent, if it has one.
+using LocalTransform = Transform;
+
 } // namespace Blackthorn::ECS::Components
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cmath>
+
+#include <glm/glm.hpp>
+
+#include "Core/Export.h"
+#include "ECS/Components/Transform.h"
+
+namespace Blackthorn::ECS::Components {
+
+// Cached result of composing every ancestor's Transform with the entity's
+// own; kept up to date by TransformSystem.
+struct BLACKTHORN_API WorldTransform {
+	glm::vec2 position{0, 0};
+	float angle = 0.0f;
+	float scale = 1.0f;
+
+	BLACKTHORN_API WorldTransform() = default;
+	BLACKTHORN_API WorldTransform(const Transform& local)
+		: position(local.position), angle(local.angle), scale(local.scale) {}
+
+	static WorldTransform compose(const WorldTransform& parent, const Transform& local) {
+		float c = std::cos(parent.angle);
+		float s = std::sin(parent.angle);
+		glm::vec2 offset = local.position * parent.scale;
+
+		WorldTransform world;
+		world.position = parent.position + glm::vec2(offset.x * c - offset.y * s, offset.x * s + offset.y * c);
+		world.angle = parent.angle + local.angle;
+		world.scale = parent.scale * local.scale;
+		return world;
+	}
+
+	glm::mat3 matrix() const {
+		float c = std::cos(angle) * scale;
+		float s = std::sin(angle) * scale;
+
+		return glm::mat3(
+			glm::vec3(c, s, 0.0f),
+			glm::vec3(-s, c, 0.0f),
+			glm::vec3(position.x, position.y, 1.0f)
+		);
+	}
+};
+
+} // namespace Blackthorn::ECS::Components
@@ -2,15 +2,28 @@
 
 #include <atomic>
 #include <cassert>
+#include <type_traits>
 
+#include "ECS/Bitset.h"
 #include "ECS/Entity.h"
+#include "ECS/TypeRegistry.h"
+
+// Component types one pool can hold. Masks round it up to whole 64-bit
+// words; the default keeps them at a single word.
+#ifndef BLACKTHORN_MAX_COMPONENTS
+	#define BLACKTHORN_MAX_COMPONENTS 64
+#endif
 
 namespace Blackthorn::ECS::Detail {
-	constexpr Uint32 MAX_ENTITIES = 8192;
 	constexpr Uint8 INDEX_BITS = 24;
 	constexpr Uint32 INDEX_MASK = (1u << INDEX_BITS) - 1;
+	constexpr Uint32 MAX_ENTITIES = INDEX_MASK;
+	constexpr Uint32 INITIAL_ENTITY_CAPACITY = 1024;
+	constexpr Uint32 SPARSE_PAGE_SIZE = 4096;
 	constexpr Uint32 GENERATION_BITS = 32 - INDEX_BITS;
-	constexpr size_t MAX_COMPONENTS = 64;
+	constexpr size_t MAX_COMPONENTS = BLACKTHORN_MAX_COMPONENTS;
+
+	using ComponentMask = Bitset<(MAX_COMPONENTS + 63) / 64>;
 
 	inline Uint32 entityIndex(Entity e) noexcept {
 		return e & INDEX_MASK;
@@ -24,25 +37,34 @@ namespace Blackthorn::ECS::Detail {
 		return (static_cast<Entity>(generation) << INDEX_BITS) | (index & INDEX_MASK);
 	}
 
-	inline size_t nextComponentID() {
-		static std::atomic<size_t> id{0};
-		return id.fetch_add(1, std::memory_order_relaxed);
-	}
-
+	// Each module caches the id in its own static, but the id itself comes
+	// from the engine's registry, so every module agrees on it.
 	template <typename T>
 	inline size_t componentID() {
-		static size_t id = nextComponentID();
+		static size_t id = TypeRegistry::global().assure(typeHash<T>, typeName<T>());
 		return id;
 	}
 
 	template <typename T>
-	inline Uint64 componentMask() noexcept {
-		size_t id = componentID<T>();
-		assert(id < MAX_COMPONENTS);
-		return (1ULL << id);
+	inline ComponentMask componentMask() {
+		return ComponentMask::bit(componentID<T>());
 	}
 
+	template <typename... Ts>
+	struct TypeList {};
+
 	template <typename T>
 	using RawType = std::remove_cv_t<std::remove_pointer_t<T>>;
 
+	// Empty component types are tags: a bit in the entity's mask, no storage.
+	template <typename T>
+	constexpr bool isTag = std::is_empty_v<T>;
+
+	// Stands in wherever a tag has to be returned by reference or pointer.
+	template <typename T>
+	inline T& tagInstance() {
+		static T instance;
+		return instance;
+	}
+
 } // namespace Blackthorn::ECS::Detail
\ No newline at end of file
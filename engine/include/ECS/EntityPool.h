@@ -1,139 +1,999 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 
 #include "Core/Export.h"
+#include "Core/JobSystem.h"
+#include "ECS/ArchetypeStorage.h"
+#include "ECS/CommandBuffer.h"
 #include "ECS/ComponentArray.h"
 #include "ECS/Detail.h"
+#include "ECS/Filters.h"
+#include "ECS/Observer.h"
+#include "ECS/Prefab.h"
+#include "ECS/Snapshot.h"
 
 namespace Blackthorn::ECS {
 
 namespace Detail {
-template <typename ...Components>
-class View; 
+template <typename FetchList, typename FilterList>
+class View;
+
+template <typename... Components>
+using ViewType = View<
+	typename Partition<TypeList<>, TypeList<>, Components...>::Fetch,
+	typename Partition<TypeList<>, TypeList<>, Components...>::Filter
+>;
+
+template <typename OwnedList, typename GetList>
+class Group;
+
+constexpr size_t NO_GROUP = SIZE_MAX;
 } // namespace Detail
 
+template <typename... Components>
+struct Get {};
+
+enum class StorageMode {
+	SparseSet,
+	Archetype
+};
+
 class BLACKTHORN_API EntityPool {
 private:
 	struct EntityData {
 		Uint8 generation = 0;
-		Uint64 componentMask = 0;
+		Detail::ComponentMask componentMask;
 	};
 
 	std::vector<EntityData> entities;
 	std::vector<Uint32> freeList;
-	std::array<std::unique_ptr<IComponentArray>, Detail::MAX_COMPONENTS> componentArrays;
+	std::vector<std::unique_ptr<IComponentArray>> componentArrays;
+	ArchetypeStorage archetypeStorage;
+	StorageMode storageMode;
 	size_t entityCount = 0;
+	Uint32 changeTick = 1;
+	JobSystem* jobSystem = nullptr;
+	std::vector<std::unique_ptr<CommandBuffer>> commandBuffers;
+
+	struct GroupData {
+		Detail::ComponentMask ownedMask;
+		Detail::ComponentMask requiredMask;
+		std::vector<size_t> owned;
+		size_t size = 0;
+	};
+
+	std::vector<GroupData> groups;
+	Detail::ComponentMask groupOwnedMask;
+
+	std::vector<std::unique_ptr<Detail::Observer>> observers;
+	std::array<Detail::ComponentMask, Detail::OBSERVER_EVENT_COUNT> observedMasks{};
+	ObserverID nextObserverID = 1;
+	Uint32 dispatchDepth = 0;
+
+	template <typename FetchList, typename FilterList>
+	friend class Detail::View;
+
+	template <typename OwnedList, typename GetList>
+	friend class Detail::Group;
+
+	template <typename Component>
+	friend class Detail::CommandQueue;
+
+	template <typename Component>
+	ComponentArray<Component>* getArray() {
+		size_t id = Detail::componentID<Component>();
+		return id < componentArrays.size() ? static_cast<ComponentArray<Component>*>(componentArrays[id].get()) : nullptr;
+	}
+
+	template <typename Component>
+	ComponentArray<Component>* assureArray() {
+		size_t id = Detail::componentID<Component>();
+
+		// Ids are handed out process-wide as types are first used, so the
+		// table only grows as far as the types this pool has actually seen.
+		if (id >= componentArrays.size())
+			componentArrays.resize(id + 1);
+
+		if (!componentArrays[id])
+			componentArrays[id] = std::make_unique<ComponentArray<Component>>();
+
+		return static_cast<ComponentArray<Component>*>(componentArrays[id].get());
+	}
+
+	template <typename Component>
+	void insertSparse(std::span<const Entity> targets, const Component& value) {
+		if constexpr (!Detail::isTag<Component>)
+			assureArray<Component>()->insertMany(changeTick, targets, value);
+	}
+
+	// Moves each queue's resolved inserts in one pass per type. Archetype
+	// entities gaining several types move once, and observers run after
+	// every type has landed, so none sees a half-applied batch.
+	void insertCommands(CommandBuffer& batch) {
+		struct Applied {
+			size_t id;
+			std::vector<Entity> added;
+			std::vector<Entity> replaced;
+		};
+
+		std::vector<Detail::ICommandQueue*> pending;
+		std::vector<Applied> applied;
+
+		for (auto& queue : batch.queues) {
+			if (!queue)
+				continue;
+
+			queue->resolveInserts(*this, batch.created);
+
+			if (queue->insertTargets().empty())
+				continue;
+
+			pending.push_back(queue.get());
+			size_t id = queue->component();
+
+			if (!isObserved(ObserverEvent::Add, id) && !isObserved(ObserverEvent::Replace, id))
+				continue;
+
+			Applied& split = applied.emplace_back(Applied{ id, {}, {} });
+
+			for (Entity entity : queue->insertTargets())
+				(entities[Detail::entityIndex(entity)].componentMask.test(id) ? split.replaced : split.added).push_back(entity);
+		}
+
+		if (storageMode == StorageMode::Archetype && pending.size() > 1) {
+			std::unordered_map<Entity, Detail::ComponentMask> gained;
+
+			for (Detail::ICommandQueue* queue : pending) {
+				for (Entity entity : queue->insertTargets())
+					gained[entity].set(queue->component());
+			}
+
+			for (const auto& [entity, mask] : gained)
+				archetypeStorage.extend(entity, mask);
+		}
+
+		for (Detail::ICommandQueue* queue : pending)
+			queue->applyInserts(*this);
+
+		for (const Applied& split : applied) {
+			notify(ObserverEvent::Add, split.id, split.added);
+			notify(ObserverEvent::Replace, split.id, split.replaced);
+		}
+	}
+
+	// Lands one command queue's inserts; `targets` are live and listed once.
+	template <typename Component>
+	void insertResolved(std::span<const Entity> targets, std::span<Component> values) {
+		Detail::ComponentMask bit = Detail::componentMask<Component>();
+
+		if (storageMode == StorageMode::Archetype) {
+			std::vector<Detail::ComponentMask> previous;
+			previous.reserve(targets.size());
+
+			for (Entity entity : targets)
+				previous.push_back(entities[Detail::entityIndex(entity)].componentMask);
+
+			archetypeStorage.insertMany<Component>(changeTick, targets, values, previous);
+		} else if constexpr (!Detail::isTag<Component>) {
+			assureArray<Component>()->insertMany(changeTick, targets, values);
+		}
+
+		for (Entity entity : targets)
+			entities[Detail::entityIndex(entity)].componentMask |= bit;
+
+		if (storageMode == StorageMode::SparseSet && !groups.empty()) {
+			for (Entity entity : targets)
+				enterGroups(entity, bit);
+		}
+	}
+
+	template <typename... Components>
+	static Detail::ComponentMask requiredMaskOf() {
+		Detail::ComponentMask mask;
+		((std::is_pointer_v<Components> ? void() : void(mask |= Detail::componentMask<Detail::RawType<Components>>())), ...);
+		return mask;
+	}
+
+	bool inGroup(const GroupData& group, Entity entity) const {
+		const auto& array = componentArrays[group.owned.front()];
+
+		if (!array)
+			return false;
+
+		Uint32 pos = array->indexOf(entity);
+		return pos != INVALID_ENTITY && pos < group.size;
+	}
+
+	void enterGroup(GroupData& group, Entity entity) {
+		const Detail::ComponentMask& mask = entities[Detail::entityIndex(entity)].componentMask;
+
+		if (!mask.contains(group.requiredMask) || inGroup(group, entity))
+			return;
+
+		for (size_t id : group.owned) {
+			auto& array = componentArrays[id];
+			array->swapEntries(array->indexOf(entity), static_cast<Uint32>(group.size));
+		}
+
+		++group.size;
+	}
+
+	void enterGroups(Entity entity, const Detail::ComponentMask& changed) {
+		for (auto& group : groups) {
+			if (group.requiredMask.intersects(changed))
+				enterGroup(group, entity);
+		}
+	}
+
+	void leaveGroups(Entity entity, const Detail::ComponentMask& changed) {
+		for (auto& group : groups) {
+			if (!group.requiredMask.intersects(changed) || !inGroup(group, entity))
+				continue;
+
+			--group.size;
+
+			for (size_t id : group.owned) {
+				auto& array = componentArrays[id];
+				array->swapEntries(array->indexOf(entity), static_cast<Uint32>(group.size));
+			}
+		}
+	}
+
+	bool isObserved(ObserverEvent event, const Detail::ComponentMask& mask) const {
+		return observedMasks[static_cast<size_t>(event)].intersects(mask);
+	}
+
+	bool isObserved(ObserverEvent event, size_t id) const {
+		return observedMasks[static_cast<size_t>(event)].test(id);
+	}
+
+	void rebuildObservedMasks() {
+		observedMasks.fill({});
+
+		for (const auto& observer : observers) {
+			if (observer->callback)
+				observedMasks[static_cast<size_t>(observer->event)].set(observer->component);
+		}
+	}
+
+	// Observers removed from inside a callback are only unlinked once no
+	// dispatch is running, so index-based loops over `observers` stay valid.
+	void compactObservers() {
+		if (dispatchDepth == 0)
+			std::erase_if(observers, [](const auto& observer) { return !observer->callback; });
+	}
+
+	void notify(ObserverEvent event, size_t id, std::span<const Entity> targets) {
+		if (targets.empty() || !isObserved(event, id))
+			return;
+
+		++dispatchDepth;
+
+		for (size_t i = 0; i < observers.size(); ++i) {
+			Detail::Observer& observer = *observers[i];
+
+			if (observer.event != event || observer.component != id || !observer.callback)
+				continue;
+
+			if (observer.delivery == ObserverDelivery::Deferred)
+				observer.pending.insert(observer.pending.end(), targets.begin(), targets.end());
+			else
+				observer.callback(*this, targets);
+		}
+
+		--dispatchDepth;
+		compactObservers();
+	}
+
+	// Splits a bulk insert into add and replace events using the masks the
+	// entities had before it.
+	void notifyInserted(size_t id, std::span<const Entity> targets, const std::vector<Detail::ComponentMask>& previous) {
+		if (!isObserved(ObserverEvent::Add, id) && !isObserved(ObserverEvent::Replace, id))
+			return;
+
+		std::vector<Entity> added;
+		std::vector<Entity> replaced;
+
+		for (size_t i = 0; i < targets.size(); ++i)
+			(previous[i].test(id) ? replaced : added).push_back(targets[i]);
+
+		notify(ObserverEvent::Add, id, added);
+		notify(ObserverEvent::Replace, id, replaced);
+	}
+
+	ObserverID observe(ObserverEvent event, size_t id, ObserverCallback callback, ObserverDelivery delivery) {
+		auto observer = std::make_unique<Detail::Observer>();
+		observer->id = nextObserverID++;
+		observer->component = id;
+		observer->event = event;
+		observer->delivery = delivery;
+		observer->callback = std::move(callback);
+
+		ObserverID observerID = observer->id;
+		observers.push_back(std::move(observer));
+		rebuildObservedMasks();
+		return observerID;
+	}
+
+	// The array part of restoreSnapshot: every array is loaded into a new
+	// one first, then all of them are swapped in along with group sizes.
+	void restoreArrays(SnapshotReader& reader, const Detail::TypeRemap& remap, Uint32 tick) {
+		std::vector<std::unique_ptr<IComponentArray>> restored(componentArrays.size());
+		Uint32 arrayCount = reader.read<Uint32>();
+
+		for (Uint32 i = 0; i < arrayCount; ++i) {
+			size_t id = remap(reader.read<Uint32>());
+
+			if (id >= componentArrays.size() || !componentArrays[id])
+				throw std::runtime_error("Snapshot: Component type not registered with this pool");
+
+			if (restored[id])
+				throw std::runtime_error("Snapshot: Component array saved twice");
+
+			restored[id] = componentArrays[id]->create();
+			restored[id]->load(reader, tick);
+		}
+
+		std::vector<size_t> groupSizes(groups.size(), Detail::NO_GROUP);
+		Uint32 groupCount = reader.read<Uint32>();
+
+		for (Uint32 i = 0; i < groupCount; ++i) {
+			auto ownedMask = remap(reader.read<Detail::ComponentMask>());
+			auto requiredMask = remap(reader.read<Detail::ComponentMask>());
+			size_t size = reader.read<Uint64>();
+
+			for (size_t g = 0; g < groups.size(); ++g) {
+				if (groups[g].ownedMask == ownedMask && groups[g].requiredMask == requiredMask && restored[groups[g].owned.front()])
+					groupSizes[g] = std::min(size, restored[groups[g].owned.front()]->size());
+			}
+		}
+
+		// Nothing below throws.
+		for (size_t id = 0; id < componentArrays.size(); ++id) {
+			if (restored[id])
+				componentArrays[id] = std::move(restored[id]);
+			else if (componentArrays[id])
+				componentArrays[id]->clear();
+		}
+
+		for (size_t g = 0; g < groups.size(); ++g)
+			groups[g].size = groupSizes[g];
+	}
+
+public:
+	explicit EntityPool(size_t initialCapacity = Detail::INITIAL_ENTITY_CAPACITY, StorageMode mode = StorageMode::SparseSet)
+		: storageMode(mode)
+	{
+		entities.reserve(initialCapacity);
+		commandBuffers.push_back(std::make_unique<CommandBuffer>());
+	}
+
+	Entity create() {
+		Uint32 index;
+
+		if (!freeList.empty()) {
+			index = freeList.back();
+			freeList.pop_back();
+		} else {
+			if (entities.size() >= Detail::MAX_ENTITIES)
+				throw std::runtime_error("EntityPool: Out of entity slots");
+
+			index = static_cast<Uint32>(entities.size());
+			entities.emplace_back();
+		}
+
+		Entity entity = Detail::makeEntity(index, entities[index].generation);
+		++entityCount;
+		return entity;
+	}
+
+	// Fills `out` with new entities: recycled slots first, then one resize of
+	// the entity table for the rest.
+	void createMany(std::span<Entity> out) {
+		size_t reused = std::min(out.size(), freeList.size());
+		size_t fresh = out.size() - reused;
+
+		if (entities.size() + fresh > Detail::MAX_ENTITIES)
+			throw std::runtime_error("EntityPool: Out of entity slots");
+
+		for (size_t i = 0; i < reused; ++i) {
+			Uint32 index = freeList.back();
+			freeList.pop_back();
+			out[i] = Detail::makeEntity(index, entities[index].generation);
+		}
+
+		Uint32 first = static_cast<Uint32>(entities.size());
+		entities.resize(entities.size() + fresh);
+
+		for (size_t i = 0; i < fresh; ++i)
+			out[reused + i] = Detail::makeEntity(first + static_cast<Uint32>(i), 0);
+
+		entityCount += out.size();
+	}
+
+	std::vector<Entity> createMany(size_t count) {
+		std::vector<Entity> created(count);
+		createMany(created);
+		return created;
+	}
+
+	// Copies of `prefab`'s components go to `count` new entities. In archetype
+	// mode they are built in place in their final archetype.
+	void instantiate(const Prefab& prefab, std::span<Entity> out) {
+		createMany(out);
+
+		if (prefab.empty())
+			return;
+
+		if (storageMode == StorageMode::Archetype) {
+			for (const auto& component : prefab.components) {
+				if (component)
+					component->registerWith(*this);
+			}
+
+			archetypeStorage.spawn(changeTick, out, prefab.mask, [&prefab](size_t id, void* memory, size_t count) {
+				prefab.components[id]->fill(memory, count);
+			});
+
+			for (Entity entity : out)
+				entities[Detail::entityIndex(entity)].componentMask = prefab.mask;
+
+			for (size_t id = 0; id < prefab.components.size(); ++id) {
+				if (prefab.components[id])
+					notify(ObserverEvent::Add, id, out);
+			}
+
+			return;
+		}
+
+		for (const auto& component : prefab.components) {
+			if (component)
+				component->addTo(*this, out);
+		}
+	}
+
+	std::vector<Entity> instantiate(const Prefab& prefab, size_t count) {
+		std::vector<Entity> created(count);
+		instantiate(prefab, created);
+		return created;
+	}
+
+	void destroy(Entity entity) {
+		Uint32 index = Detail::entityIndex(entity);
+
+		if (!isValid(entity))
+			return;
+
+		Detail::ComponentMask observed = entities[index].componentMask & observedMasks[static_cast<size_t>(ObserverEvent::Remove)];
+
+		observed.forEach([&](size_t id) {
+			notify(ObserverEvent::Remove, id, std::span<const Entity>(&entity, 1));
+		});
+
+		if (!isValid(entity))
+			return;
+
+		Detail::ComponentMask mask = entities[index].componentMask;
+
+		if (storageMode == StorageMode::Archetype) {
+			archetypeStorage.destroy(entity);
+		} else {
+			if (!groups.empty())
+				leaveGroups(entity, mask);
+
+			mask.forEach([&](size_t id) {
+				if (id < componentArrays.size() && componentArrays[id])
+					componentArrays[id]->remove(entity);
+			});
+		}
+
+		entities[index].componentMask = {};
+		entities[index].generation++;
+		freeList.push_back(index);
+		--entityCount;
+	}
+
+	bool isValid(Entity entity) const {
+		if (entity == INVALID_ENTITY)
+			return false;
+
+		Uint32 index = Detail::entityIndex(entity);
+
+		if (index >= entities.size())
+			return false;
+
+		return entities[index].generation == Detail::entityGeneration(entity);
+	}
+
+	size_t aliveCount() const { return entityCount; }
+
+	// Monotonic change counter; components added or written through a view
+	// are stamped with its current value. SystemManager advances it per stage.
+	Uint32 getChangeTick() const { return changeTick; }
+	Uint32 advanceTick() { return ++changeTick; }
+	StorageMode getStorageMode() const { return storageMode; }
+
+	void setJobSystem(JobSystem* jobs) {
+		jobSystem = jobs;
+		assureCommandBuffers();
+	}
+
+	JobSystem* getJobSystem() const { return jobSystem; }
+
+	void assureCommandBuffers() {
+		size_t threads = jobSystem ? jobSystem->getThreadCount() : 1;
+
+		while (commandBuffers.size() < threads)
+			commandBuffers.push_back(std::make_unique<CommandBuffer>());
+	}
+
+	CommandBuffer& commands() {
+		Uint32 index = JobSystem::currentThreadIndex();
+		assert(index < commandBuffers.size());
+		return *commandBuffers[index];
+	}
+
+	// Applies what `buffer` holds now. Immediate observers that record into
+	// it during playback land in a fresh buffer, applied by the next call.
+	void playback(CommandBuffer& buffer) {
+		if (buffer.empty())
+			return;
+
+		CommandBuffer batch;
+		batch.swap(buffer);
+
+		batch.created.resize(batch.pendingCount);
+		createMany(batch.created);
+		insertCommands(batch);
+
+		for (auto& queue : batch.queues) {
+			if (queue)
+				queue->applyRemoves(*this, batch.created);
+		}
+
+		for (const Detail::CommandTarget& target : batch.destroys)
+			destroy(target.resolve(batch.created));
+
+		// Hands the queues' allocations back unless observers recorded meanwhile.
+		batch.clear();
+
+		if (buffer.empty())
+			buffer.swap(batch);
+	}
+
+	void playbackCommands() {
+		for (auto& buffer : commandBuffers)
+			playback(*buffer);
+
+		assureCommandBuffers();
+		flushObservers();
+	}
+
+	template <typename Component>
+	ObserverID onAdd(ObserverCallback callback, ObserverDelivery delivery = ObserverDelivery::Immediate) {
+		return observe(ObserverEvent::Add, Detail::componentID<Component>(), std::move(callback), delivery);
+	}
+
+	template <typename Component>
+	ObserverID onRemove(ObserverCallback callback, ObserverDelivery delivery = ObserverDelivery::Immediate) {
+		return observe(ObserverEvent::Remove, Detail::componentID<Component>(), std::move(callback), delivery);
+	}
+
+	template <typename Component>
+	ObserverID onReplace(ObserverCallback callback, ObserverDelivery delivery = ObserverDelivery::Immediate) {
+		return observe(ObserverEvent::Replace, Detail::componentID<Component>(), std::move(callback), delivery);
+	}
+
+	// Called after every restoreSnapshot, so state derived from the pool
+	// (lookup tables, caches) can be rebuilt from the restored contents.
+	ObserverID onRestore(std::function<void(EntityPool&)> callback) {
+		return observe(ObserverEvent::Restore, 0, [callback = std::move(callback)](EntityPool& pool, std::span<const Entity>) {
+			callback(pool);
+		}, ObserverDelivery::Immediate);
+	}
+
+	void removeObserver(ObserverID id) {
+		for (auto& observer : observers) {
+			if (observer->id != id)
+				continue;
+
+			observer->callback = nullptr;
+			observer->pending.clear();
+		}
+
+		rebuildObservedMasks();
+		compactObservers();
+	}
+
+	// Hands every deferred observer the entities collected since the last
+	// flush. Events raised by the callbacks wait for the next one.
+	void flushObservers() {
+		++dispatchDepth;
+
+		for (size_t i = 0; i < observers.size(); ++i) {
+			Detail::Observer& observer = *observers[i];
+
+			if (observer.pending.empty() || !observer.callback)
+				continue;
+
+			std::swap(observer.pending, observer.delivering);
+			observer.callback(*this, observer.delivering);
+			observer.delivering.clear();
+		}
+
+		--dispatchDepth;
+		compactObservers();
+	}
+
+	void clear() {
+		for (auto& ca : componentArrays) {
+			if (ca)
+				ca.reset();
+		}
+
+		archetypeStorage.clear();
+
+		for (auto& group : groups)
+			group.size = 0;
+
+		for (auto& observer : observers)
+			observer->pending.clear();
+
+		entities.clear();
+		freeList.clear();
+
+		entityCount = 0;
+	}
+
+	// Independent copy of every entity and component, with change ticks and
+	// group layout intact. Observers and pending commands are not copied;
+	// the copy shares this pool's job system.
+	EntityPool clone() const {
+		EntityPool copy(entities.capacity(), storageMode);
+		copy.entities = entities;
+		copy.freeList = freeList;
+		copy.entityCount = entityCount;
+		copy.changeTick = changeTick;
+		copy.groups = groups;
+		copy.groupOwnedMask = groupOwnedMask;
+
+		if (storageMode == StorageMode::Archetype) {
+			copy.archetypeStorage = archetypeStorage.clone();
+		} else {
+			copy.componentArrays.resize(componentArrays.size());
+
+			for (size_t id = 0; id < componentArrays.size(); ++id) {
+				if (componentArrays[id])
+					copy.componentArrays[id] = componentArrays[id]->clone();
+			}
+		}
+
+		copy.setJobSystem(jobSystem);
+		return copy;
+	}
+
+	const std::vector<EntityData>& getEntities() const { return entities; }
+
+	// Makes a component type known to the pool without adding it anywhere,
+	// so snapshots containing it can be restored into a fresh pool.
+	template <typename Component>
+	void registerComponent() {
+		if (storageMode == StorageMode::Archetype)
+			archetypeStorage.registerComponent<Component>();
+		else if constexpr (Detail::isTag<Component>)
+			Detail::componentID<Component>();
+		else
+			assureArray<Component>();
+	}
+
+	// Component ids are written as this process numbers them, preceded by
+	// the type hash of each id so another process can map them to its own.
+	void saveSnapshot(Snapshot& snapshot) const {
+		snapshot.clear();
+		SnapshotWriter writer(snapshot);
+
+		writer.write(Detail::SNAPSHOT_MAGIC);
+		writer.write(Detail::SNAPSHOT_VERSION);
+		writer.write(static_cast<Uint8>(storageMode));
+		writer.write(changeTick);
+		Detail::TypeRemap::write(writer);
+
+		writer.write(static_cast<Uint64>(entityCount));
+		writer.write(static_cast<Uint64>(entities.size()));
+		writer.write(entities.data(), entities.size() * sizeof(EntityData));
+		writer.write(static_cast<Uint64>(freeList.size()));
+		writer.write(freeList.data(), freeList.size() * sizeof(Uint32));
+
+		if (storageMode == StorageMode::Archetype) {
+			archetypeStorage.save(writer);
+			return;
+		}
+
+		Uint32 arrayCount = static_cast<Uint32>(std::count_if(componentArrays.begin(), componentArrays.end(), [](const auto& array) { return array != nullptr; }));
+		writer.write(arrayCount);
+
+		for (size_t id = 0; id < componentArrays.size(); ++id) {
+			if (!componentArrays[id])
+				continue;
+
+			writer.write(static_cast<Uint32>(id));
+			componentArrays[id]->save(writer);
+		}
+
+		writer.write(static_cast<Uint32>(groups.size()));
+
+		for (const auto& group : groups) {
+			writer.write(group.ownedMask);
+			writer.write(group.requiredMask);
+			writer.write(static_cast<Uint64>(group.size));
+		}
+	}
+
+	// Replaces the pool's contents with the snapshot. Pending commands and
+	// deferred observer events are dropped, and no component observer
+	// fires; restore observers run once at the end. Groups missing from the
+	// snapshot are rebuilt.
+	//
+	// The whole snapshot is read before anything is replaced, so a bad one
+	// throws and leaves the pool as it was. The change tick keeps moving
+	// forward and every restored component counts as added and changed at
+	// the new tick, so Added<> and Changed<> views see the rollback.
+	void restoreSnapshot(const Snapshot& snapshot) {
+		SnapshotReader reader(snapshot);
+
+		if (reader.read<Uint32>() != Detail::SNAPSHOT_MAGIC || reader.read<Uint32>() != Detail::SNAPSHOT_VERSION)
+			throw std::runtime_error("Snapshot: Unrecognized format");
+
+		if (static_cast<StorageMode>(reader.read<Uint8>()) != storageMode)
+			throw std::runtime_error("Snapshot: Storage mode mismatch");
+
+		Uint32 tick = std::max(changeTick, reader.read<Uint32>()) + 1;
+
+		Detail::TypeRemap remap;
+		remap.read(reader);
+
+		size_t restoredCount = reader.read<Uint64>();
+
+		std::vector<EntityData> restoredEntities(reader.readCount(sizeof(EntityData)));
+		reader.read(restoredEntities.data(), restoredEntities.size() * sizeof(EntityData));
+
+		std::vector<Uint32> restoredFree(reader.readCount(sizeof(Uint32)));
+		reader.read(restoredFree.data(), restoredFree.size() * sizeof(Uint32));
+
+		if (restoredCount > restoredEntities.size())
+			throw std::runtime_error("Snapshot: Entity count out of range");
+
+		for (Uint32 index : restoredFree) {
+			if (index >= restoredEntities.size())
+				throw std::runtime_error("Snapshot: Free list out of range");
+		}
+
+		for (auto& data : restoredEntities)
+			data.componentMask = remap(data.componentMask);
+
+		if (storageMode == StorageMode::Archetype) {
+			ArchetypeStorage restoredStorage = archetypeStorage.emptyClone();
+			restoredStorage.load(reader, remap, tick);
+			archetypeStorage = std::move(restoredStorage);
+		} else {
+			restoreArrays(reader, remap, tick);
+		}
+
+		changeTick = tick;
+		entityCount = restoredCount;
+		entities = std::move(restoredEntities);
+		freeList = std::move(restoredFree);
+
+		for (auto& buffer : commandBuffers)
+			buffer->clear();
+
+		for (auto& observer : observers)
+			observer->pending.clear();
+
+		// Groups the snapshot didn't have are rebuilt from the new contents.
+		for (auto& group : groups) {
+			if (storageMode == StorageMode::Archetype || group.size != Detail::NO_GROUP)
+				continue;
+
+			group.size = 0;
+
+			std::vector<Entity> candidates = componentArrays[group.owned.front()]->entities();
+			for (Entity entity : candidates)
+				enterGroup(group, entity);
+		}
+
+		if (!isObserved(ObserverEvent::Restore, 0))
+			return;
+
+		++dispatchDepth;
+
+		for (size_t i = 0; i < observers.size(); ++i) {
+			Detail::Observer& observer = *observers[i];
+
+			if (observer.event == ObserverEvent::Restore && observer.callback)
+				observer.callback(*this, {});
+		}
+
+		--dispatchDepth;
+		compactObservers();
+	}
+
+	template <typename Component, typename... Args>
+	Component& addComponent(Entity entity, Args&&... args) {
+		if (!isValid(entity))
+			throw std::runtime_error("EntityPool: Invalid entity");
+
+		Uint32 index = Detail::entityIndex(entity);
+		Detail::ComponentMask bit = Detail::componentMask<Component>();
+		ObserverEvent event = entities[index].componentMask.intersects(bit) ? ObserverEvent::Replace : ObserverEvent::Add;
+		Component* component;
+
+		if (storageMode == StorageMode::Archetype) {
+			component = &archetypeStorage.insert<Component>(changeTick, entity, std::forward<Args>(args)...);
+			entities[index].componentMask |= bit;
+		} else if constexpr (Detail::isTag<Component>) {
+			entities[index].componentMask |= bit;
+			component = &Detail::tagInstance<Component>();
+		} else {
+			auto* array = assureArray<Component>();
+			array->insert(changeTick, entity, std::forward<Args>(args)...);
+
+			entities[index].componentMask |= bit;
+
+			if (!groups.empty())
+				enterGroups(entity, bit);
+
+			// Entering a group may have swapped the new component elsewhere.
+			component = array->get(entity);
+		}
 
-public:
-	explicit EntityPool(size_t maxEntities = Detail::MAX_ENTITIES) {
-		entities.resize(maxEntities);
-		freeList.reserve(maxEntities);
+		if (isObserved(event, bit)) {
+			notify(event, Detail::componentID<Component>(), std::span<const Entity>(&entity, 1));
+
+			// Immediate observers may have changed the entity's layout.
+			component = getComponent<Component>(entity);
+			assert(component && "Component removed by its own add observer");
+		}
 
-		for (Sint32 i = static_cast<Sint32>(maxEntities) - 1; i >= 0; --i)
-			freeList.push_back(static_cast<Uint32>(i));
+		return *component;
 	}
 
-	Entity create() {
-		if (freeList.empty()) {
-			throw std::runtime_error("EntityPool: Out of entity slots");
+	// Bulk addComponent: every entity (listed once) gets a copy of each value.
+	// Sparse sets take one contiguous fill per type; archetype mode moves each
+	// entity once.
+	template <typename... Components>
+	void addComponents(std::span<const Entity> targets, const Components&... values) {
+		static_assert(sizeof...(Components) > 0, "addComponents needs at least one component");
+
+		for (Entity entity : targets) {
+			if (!isValid(entity))
+				throw std::runtime_error("EntityPool: Invalid entity");
 		}
 
-		Uint32 index = freeList.back();
-		freeList.pop_back();
+		Detail::ComponentMask added = (Detail::componentMask<Components>() | ...);
+		bool observed = isObserved(ObserverEvent::Add, added) || isObserved(ObserverEvent::Replace, added);
+		std::vector<Detail::ComponentMask> previous;
 
-		Entity entity = Detail::makeEntity(index, entities[index].generation);
-		++entityCount;
-		return entity;
-	}
+		if (observed) {
+			previous.reserve(targets.size());
 
-	void destroy(Entity entity) {
-		Uint32 index = Detail::entityIndex(entity);
+			for (Entity entity : targets)
+				previous.push_back(entities[Detail::entityIndex(entity)].componentMask);
+		}
 
-		if (!isValid(entity))
-			return;
+		if (storageMode == StorageMode::Archetype)
+			archetypeStorage.insertMany<Components...>(changeTick, targets, values...);
+		else
+			(insertSparse<Components>(targets, values), ...);
 
-		Uint64 mask = entities[index].componentMask;
-		for (size_t i = 0; mask && i < Detail::MAX_COMPONENTS; ++i) {
-			if (mask & (1ULL << i)) {
-				if (componentArrays[i])
-					componentArrays[i]->remove(entity);
+		for (Entity entity : targets)
+			entities[Detail::entityIndex(entity)].componentMask |= added;
 
-				mask &= ~(1ULL << i);
-			}
+		if (storageMode == StorageMode::SparseSet && !groups.empty()) {
+			for (Entity entity : targets)
+				enterGroups(entity, added);
 		}
 
-		entities[index].componentMask = 0;
-		entities[index].generation++;
-		freeList.push_back(index);
-		--entityCount;
+		if (observed)
+			(notifyInserted(Detail::componentID<Components>(), targets, previous), ...);
 	}
 
-	bool isValid(Entity entity) const {
-		if (entity == INVALID_ENTITY)
-			return false;
+	template <typename Component>
+	void reserveComponents(size_t count) {
+		if constexpr (!Detail::isTag<Component>) {
+			if (storageMode == StorageMode::SparseSet)
+				assureArray<Component>()->reserve(count);
+		}
+	}
+
+	template <typename Component>
+	void removeComponent(Entity entity) {
+		if (!isValid(entity))
+			return;
 
+		size_t id = Detail::componentID<Component>();
 		Uint32 index = Detail::entityIndex(entity);
 
-		if (index >= entities.size())
-			return false;
+		if (isObserved(ObserverEvent::Remove, id) && entities[index].componentMask.test(id)) {
+			notify(ObserverEvent::Remove, id, std::span<const Entity>(&entity, 1));
 
-		return entities[index].generation == Detail::entityGeneration(entity);
-	}
+			if (!isValid(entity))
+				return;
+		}
 
-	size_t aliveCount() const { return entityCount; }
+		if (storageMode == StorageMode::Archetype) {
+			archetypeStorage.remove(entity, id);
+			entities[index].componentMask.reset(id);
+			return;
+		}
 
-	void clear() {
-		for (auto& ca : componentArrays) {
-			if (ca)
-				ca.reset();
+		if constexpr (Detail::isTag<Component>) {
+			entities[index].componentMask.reset(id);
+			return;
 		}
 
-		freeList.clear();
+		if (id >= componentArrays.size() || !componentArrays[id])
+			return;
 
-		for (Sint32 i = static_cast<Sint32>(entities.size()) - 1; i >= 0; --i) {
-			entities[i] = EntityData{};
-			freeList.push_back(static_cast<Uint32>(i));
-		}
+		if (!groups.empty())
+			leaveGroups(entity, Detail::componentMask<Component>());
 
-		entityCount = 0;
-	}
+		componentArrays[id]->remove(entity);
 
-	const std::vector<EntityData> getEntities() { return entities; }
+		entities[index].componentMask.reset(id);
+	}
 
-	template <typename Component, typename... Args>
-	Component& addComponent(Entity entity, Args&&... args) {
+	template <typename Component>
+	void markChanged(Entity entity) {
 		if (!isValid(entity))
-			throw std::runtime_error("EntityPool: Invalid entity");
+			return;
 
-		size_t id = Detail::componentID<Component>();
+		if (storageMode == StorageMode::Archetype) {
+			archetypeStorage.markChanged(entity, Detail::componentID<Component>(), changeTick);
+			return;
+		}
 
-		if (!componentArrays[id])
-			componentArrays[id] = std::make_unique<ComponentArray<Component>>();
+		if (auto* array = getArray<Component>())
+			array->markChanged(entity, changeTick);
+	}
 
-		auto* array = static_cast<ComponentArray<Component>*>(componentArrays[id].get());
-		Component& component = array->insert(entity, std::forward<Args>(args)...);
+	template <typename Component>
+	Uint32 getAddedTick(Entity entity) const {
+		if (!isValid(entity))
+			return 0;
 
-		Uint32 index = Detail::entityIndex(entity);
-		entities[index].componentMask |= Detail::componentMask<Component>();
+		if (storageMode == StorageMode::Archetype)
+			return archetypeStorage.addedTick(entity, Detail::componentID<Component>());
+
+		size_t id = Detail::componentID<Component>();
+
+		if (id >= componentArrays.size() || !componentArrays[id])
+			return 0;
 
-		return component;
+		return static_cast<const ComponentArray<Component>&>(*componentArrays[id]).addedTick(entity);
 	}
 
 	template <typename Component>
-	void removeComponent(Entity entity) {
+	Uint32 getChangedTick(Entity entity) const {
 		if (!isValid(entity))
-			return;
+			return 0;
+
+		if (storageMode == StorageMode::Archetype)
+			return archetypeStorage.changedTick(entity, Detail::componentID<Component>());
 
 		size_t id = Detail::componentID<Component>();
-		if (id >= componentArrays.size() || !componentArrays[id])
-			return;
 
-		componentArrays[id]->remove(entity);
+		if (id >= componentArrays.size() || !componentArrays[id])
+			return 0;
 
-		Uint32 index = Detail::entityIndex(entity);
-		entities[index].componentMask &= ~Detail::componentMask<Component>();
+		return static_cast<const ComponentArray<Component>&>(*componentArrays[id]).changedTick(entity);
 	}
 
 	template <typename Component>
@@ -141,6 +1001,9 @@ public:
 		if (!isValid(entity))
 			return false;
 
+		if (storageMode == StorageMode::Archetype || Detail::isTag<Component>)
+			return entities[Detail::entityIndex(entity)].componentMask.test(Detail::componentID<Component>());
+
 		size_t id = Detail::componentID<Component>();
 
 		if (id >= componentArrays.size() || !componentArrays[id])
@@ -154,6 +1017,12 @@ public:
 		if (!isValid(entity))
 			return nullptr;
 
+		if constexpr (Detail::isTag<Component>)
+			return hasComponent<Component>(entity) ? &Detail::tagInstance<Component>() : nullptr;
+
+		if (storageMode == StorageMode::Archetype)
+			return archetypeStorage.get<Component>(entity);
+
 		size_t id = Detail::componentID<Component>();
 		if(id >= componentArrays.size() || !componentArrays[id])
 			return nullptr;
@@ -167,6 +1036,12 @@ public:
 		if (!isValid(entity))
 			return nullptr;
 
+		if constexpr (Detail::isTag<Component>)
+			return hasComponent<Component>(entity) ? &Detail::tagInstance<Component>() : nullptr;
+
+		if (storageMode == StorageMode::Archetype)
+			return const_cast<ArchetypeStorage&>(archetypeStorage).get<Component>(entity);
+
 		size_t id = Detail::componentID<Component>();
 		if(id >= componentArrays.size() || !componentArrays[id])
 			return nullptr;
@@ -176,89 +1051,514 @@ public:
 	}
 
 	template <typename... Components>
-	Detail::View<Components...> view() {
+	Detail::ViewType<Components...> view() {
+		using ViewType = Detail::ViewType<Components...>;
 		constexpr size_t N = sizeof...(Components);
 
+		static_assert(N == 0 || (Detail::selectsEntities<Components> || ...),
+			"A view needs a required component, With<>, AnyOf<> or a change filter; optional fetches and Without<> alone would match every entity");
+
 		if constexpr (N == 0) {
 			static std::vector<Entity> empty;
-			return View<Components...>(this, 0, &empty);
+			return ViewType(this, {}, &empty);
 		}
 
-		Uint64 requiredMask = 0;
+		Detail::ComponentMask requiredMask;
 		const std::vector<Entity>* smallestList = nullptr;
 		size_t smallestSize = SIZE_MAX;
+		bool driven = false;
 
-		auto processComponent = [&]<typename T>() {
-			using Raw = Detail::RawType<T>;
+		auto requireComponent = [&]<typename Raw>() {
 			size_t id = Detail::componentID<Raw>();
-
-			if constexpr (!std::is_pointer_v<T>) {
-				requiredMask |= Detail::componentMask<Raw>();
-
-				if (id < componentArrays.size() && componentArrays[id]) {
-					size_t size = componentArrays[id]->size();
-					if (size < smallestSize) {
-						smallestSize = size;
-						smallestList = &componentArrays[id]->entities();
-					}
+			requiredMask |= Detail::componentMask<Raw>();
+			driven = true;
+
+			if (id < componentArrays.size() && componentArrays[id]) {
+				size_t size = componentArrays[id]->size();
+				if (size < smallestSize) {
+					smallestSize = size;
+					smallestList = &componentArrays[id]->entities();
 				}
 			}
 		};
 
+		auto processComponent = [&]<typename T>() {
+			if constexpr (Detail::FilterTraits<T>::isTracking)
+				requireComponent.template operator()<typename Detail::FilterTraits<T>::Tracked>();
+			else if constexpr (Detail::FilterTraits<T>::isFilter) {
+				requiredMask |= Detail::FilterTraits<T>::requiredMask();
+
+				// Components required through With<> can drive the view too;
+				// only tags have no array to walk.
+				Detail::FilterTraits<T>::forEachRequired([&]<typename Raw>() {
+					if constexpr (!Detail::isTag<Raw>)
+						requireComponent.template operator()<Raw>();
+				});
+			} else if constexpr (!std::is_pointer_v<T>)
+				requireComponent.template operator()<Detail::RawType<T>>();
+		};
+
 		(processComponent.template operator()<Components>(), ...);
 
+		// A view selecting only through tags or AnyOf<> has no array to walk;
+		// a null list makes it test every entity's mask instead.
+		if (storageMode == StorageMode::Archetype || !driven)
+			return ViewType(this, requiredMask, nullptr);
+
 		if (!smallestList) {
 			static std::vector<Entity> empty;
-			return Detail::View<Components...>(this, requiredMask, &empty);
+			return ViewType(this, requiredMask, &empty);
+		}
+
+		return ViewType(this, requiredMask, smallestList);
+	}
+
+	template <typename... Owned, typename... Observed>
+	Detail::Group<Detail::TypeList<Owned...>, Get<Observed...>> group(Get<Observed...> = {}) {
+		static_assert(sizeof...(Owned) > 0, "Group must own at least one component");
+		static_assert(!(std::is_pointer_v<Owned> || ...), "Owned group components cannot be optional");
+		static_assert(!(Detail::isTag<Detail::RawType<Owned>> || ...) && !(Detail::isTag<Detail::RawType<Observed>> || ...), "Tags have no storage to group");
+
+		using GroupType = Detail::Group<Detail::TypeList<Owned...>, Get<Observed...>>;
+
+		if (storageMode == StorageMode::Archetype)
+			return GroupType(this, Detail::NO_GROUP);
+
+		Detail::ComponentMask ownedMask = requiredMaskOf<Owned...>();
+		Detail::ComponentMask requiredMask = ownedMask | requiredMaskOf<Observed...>();
+
+		for (size_t i = 0; i < groups.size(); ++i) {
+			if (groups[i].ownedMask == ownedMask && groups[i].requiredMask == requiredMask)
+				return GroupType(this, i);
 		}
 
-		return Detail::View<Components...>(this, requiredMask, smallestList);
+		if (groupOwnedMask.intersects(ownedMask))
+			throw std::runtime_error("EntityPool: Component already owned by another group");
+
+		(assureArray<Detail::RawType<Owned>>(), ...);
+
+		GroupData data;
+		data.ownedMask = ownedMask;
+		data.requiredMask = requiredMask;
+		data.owned = { Detail::componentID<Detail::RawType<Owned>>()... };
+
+		groups.push_back(std::move(data));
+		groupOwnedMask |= ownedMask;
+
+		std::vector<Entity> candidates = componentArrays[groups.back().owned.front()]->entities();
+		for (Entity entity : candidates)
+			enterGroup(groups.back(), entity);
+
+		return GroupType(this, groups.size() - 1);
 	}
 };
 
 namespace Detail {
 
-template <typename... Components>
-class View {
+template <typename Component>
+decltype(auto) sparseComponent(ComponentArray<RawType<Component>>* array, Entity entity, Uint32 tick) {
+	FetchType<Component>* comp = nullptr;
+
+	if constexpr (isReadOnly<Component>)
+		comp = array ? array->get(entity) : nullptr;
+	else
+		comp = array ? array->getMut(entity, tick) : nullptr;
+
+	if constexpr (std::is_pointer_v<Component>) {
+		return comp;
+	} else {
+		assert(comp != nullptr);
+		return static_cast<FetchType<Component>&>(*comp);
+	}
+}
+
+template <typename... Fetch, typename... Filters>
+class View<TypeList<Fetch...>, TypeList<Filters...>> {
+	static_assert((!isTag<RawType<Fetch>> && ...), "Tags carry no data; match them with With<T>");
+
 private: 
+	template <typename Filter>
+	using FilterArray = std::conditional_t<
+		FilterTraits<Filter>::isTracking,
+		ComponentArray<typename FilterTraits<Filter>::Tracked>*,
+		std::nullptr_t
+	>;
+
 	EntityPool* pool;
-	Uint64 requiredMask;
+	ComponentMask requiredMask;
+	ComponentMask excludedMask;
+	std::array<ComponentMask, sizeof...(Filters)> anyMasks;
 	const std::vector<Entity>* entityList;
+	Uint32 tick;
+	Uint32 sinceTick;
+
+	// Every mask filter folded into tests on the entity's (or archetype's)
+	// component mask; filters other than AnyOf leave their any-mask at 0.
+	bool matches(const ComponentMask& mask) const {
+		if (!mask.contains(requiredMask) || mask.intersects(excludedMask))
+			return false;
+
+		for (const ComponentMask& any : anyMasks) {
+			if (any.any() && !mask.intersects(any))
+				return false;
+		}
+
+		return true;
+	}
 
 public:
-	View(EntityPool* p, Uint64 mask, const std::vector<Entity>* entities)
+	View(EntityPool* p, const ComponentMask& mask, const std::vector<Entity>* entities)
 		: pool(p)
 		, requiredMask(mask)
+		, excludedMask((ComponentMask{} | ... | FilterTraits<Filters>::excludedMask()))
+		, anyMasks{ FilterTraits<Filters>::anyMask()... }
 		, entityList(entities)
+		, tick(p->changeTick)
+		, sinceTick(lastRunTick)
 	{}
 
+	// Overrides the tick Changed/Added filters compare against.
+	View& since(Uint32 changeTick) {
+		sinceTick = changeTick;
+		return *this;
+	}
+
 	template <typename Function>
 	void each(Function&& callback) {
-		if (!entityList)
+		if (pool->storageMode == StorageMode::Archetype) {
+			eachArchetype(callback, std::index_sequence_for<Fetch...>{});
 			return;
+		}
 
-		for (Entity e : *entityList) {
-			Uint32 index = Detail::entityIndex(e);
+		eachSparse(callback, 0, sparseCount(), std::index_sequence_for<Fetch...>{}, std::index_sequence_for<Filters...>{});
+	}
 
-			if ((pool->getEntities()[index].componentMask & requiredMask) != requiredMask)
-				continue;
+	template <typename Function>
+	void eachParallel(Function&& callback, size_t grainSize = 0) {
+		JobSystem* jobs = pool->jobSystem;
+
+		if (!jobs) {
+			each(callback);
+			return;
+		}
 
-			callback(e, getComponentForView<Components>(e)...);
+		if (pool->storageMode == StorageMode::Archetype) {
+			std::vector<std::pair<Archetype*, size_t>> chunks;
+			size_t capacity = 0;
+
+			for (const auto& archetype : pool->archetypeStorage.getArchetypes()) {
+				if (!matches(archetype->getMask()))
+					continue;
+
+				capacity = std::max<size_t>(capacity, archetype->chunkCapacity());
+				for (size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk)
+					chunks.emplace_back(archetype.get(), chunk);
+			}
+
+			size_t grain = grainSize ? grainSize : jobs->getGrainSize();
+			jobs->parallelFor(chunks.size(), std::max<size_t>(1, grain / std::max<size_t>(capacity, 1)), [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i)
+					eachChunk(*chunks[i].first, chunks[i].second, callback, std::index_sequence_for<Fetch...>{});
+			});
+
+			return;
 		}
+
+		jobs->parallelFor(sparseCount(), grainSize, [&](size_t begin, size_t end) {
+			eachSparse(callback, begin, end, std::index_sequence_for<Fetch...>{}, std::index_sequence_for<Filters...>{});
+		});
 	}
 
 private:
+	// Without a list the view walks every entity slot.
+	size_t sparseCount() const {
+		return entityList ? entityList->size() : pool->entities.size();
+	}
+
+	template <typename Filter>
+	FilterArray<Filter> filterArray() const {
+		if constexpr (FilterTraits<Filter>::isTracking)
+			return pool->template getArray<typename FilterTraits<Filter>::Tracked>();
+		else
+			return nullptr;
+	}
+
+	template <typename Filter>
+	bool passesSparse(FilterArray<Filter> array, Entity entity) const {
+		if constexpr (FilterTraits<Filter>::isTracking) {
+			Uint32 pos = array->indexOf(entity);
+			return FilterTraits<Filter>::passes(array->addedTickData()[pos], array->changedTickData()[pos], sinceTick);
+		} else {
+			(void)array;
+			(void)entity;
+			return true;
+		}
+	}
+
+	template <typename Function, size_t... I, size_t... J>
+	void eachSparse(Function& callback, size_t begin, size_t end, std::index_sequence<I...>, std::index_sequence<J...>) {
+		std::tuple<ComponentArray<RawType<Fetch>>*...> arrays{
+			pool->template getArray<RawType<Fetch>>()...
+		};
+		std::tuple<FilterArray<Filters>...> filterArrays{ filterArray<Filters>()... };
+
+		const auto& entityData = pool->entities;
+		const Entity* list = entityList ? entityList->data() : nullptr;
+
+		for (size_t i = begin; i < end; ++i) {
+			// Dead slots have an empty mask, so when walking slots entities
+			// without any component are skipped along with them.
+			if (!list && entityData[i].componentMask.none())
+				continue;
+
+			Entity e = list ? list[i] : makeEntity(static_cast<Uint32>(i), entityData[i].generation);
+
+			if (!matches(entityData[entityIndex(e)].componentMask))
+				continue;
+
+			if (!(passesSparse<Filters>(std::get<J>(filterArrays), e) && ...))
+				continue;
+
+			callback(e, sparseComponent<Fetch>(std::get<I>(arrays), e, tick)...);
+		}
+	}
+
+	template <typename Function, size_t... I>
+	void eachArchetype(Function& callback, std::index_sequence<I...> indices) {
+		for (const auto& archetype : pool->archetypeStorage.getArchetypes()) {
+			if (!matches(archetype->getMask()))
+				continue;
+
+			for (size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk)
+				eachChunk(*archetype, chunk, callback, indices);
+		}
+	}
+
+	template <typename Filter>
+	bool passesChunk(const Archetype& archetype, size_t chunk) const {
+		if constexpr (FilterTraits<Filter>::isTracking) {
+			size_t id = componentID<typename FilterTraits<Filter>::Tracked>();
+			return FilterTraits<Filter>::passes(archetype.addedTick(chunk, id), archetype.changedTick(chunk, id), sinceTick);
+		} else {
+			(void)archetype;
+			(void)chunk;
+			return true;
+		}
+	}
+
 	template <typename Component>
-	decltype(auto) getComponentForView(Entity entity) {
-		using Raw = Detail::RawType<Component>;
+	void markColumn(Archetype& archetype, size_t chunk) const {
+		if constexpr (!isReadOnly<Component>) {
+			size_t id = componentID<RawType<Component>>();
+
+			if (archetype.hasComponent(id))
+				archetype.markChanged(chunk, id, tick);
+		}
+	}
+
+	template <typename Function, size_t... I>
+	void eachChunk(Archetype& archetype, size_t chunk, Function& callback, std::index_sequence<I...>) const {
+		if (!(passesChunk<Filters>(archetype, chunk) && ...))
+			return;
+
+		(markColumn<Fetch>(archetype, chunk), ...);
+
+		Entity* chunkEntities = archetype.entities(chunk);
+		std::tuple<RawType<Fetch>*...> columns{
+			archetype.template column<RawType<Fetch>>(chunk)...
+		};
+
+		Uint32 count = archetype.chunkSize(chunk);
+		for (Uint32 row = 0; row < count; ++row)
+			callback(chunkEntities[row], columnForView<Fetch>(std::get<I>(columns), row)...);
+	}
 
+	template <typename Component>
+	static decltype(auto) columnForView(RawType<Component>* column, Uint32 row) {
 		if constexpr (std::is_pointer_v<Component>) {
-			return pool->getComponent<Raw>(entity);
+			return static_cast<FetchType<Component>*>(column ? column + row : nullptr);
 		} else {
-			Raw* comp = pool->getComponent<Raw>(entity);
-			assert(comp != nullptr);
-			return (*comp);
+			return static_cast<FetchType<Component>&>(column[row]);
+		}
+	}
+};
+
+template <typename... Owned, typename... Observed>
+class Group<TypeList<Owned...>, Get<Observed...>> {
+private:
+	EntityPool* pool;
+	size_t index;
+
+	template <typename Component>
+	static void markRange(ComponentArray<RawType<Component>>* array, size_t begin, size_t end, Uint32 tick) {
+		if constexpr (!isReadOnly<Component>)
+			std::fill(array->changedTickData() + begin, array->changedTickData() + end, tick);
+	}
+
+	template <typename Function, size_t... I, size_t... J>
+	void eachPacked(Function& callback, size_t begin, size_t end, std::index_sequence<I...>, std::index_sequence<J...>) {
+		if (begin >= end)
+			return;
+
+		Uint32 tick = pool->changeTick;
+		std::tuple<ComponentArray<RawType<Owned>>*...> owned{ pool->template getArray<RawType<Owned>>()... };
+		std::tuple<RawType<Owned>*...> ownedData{ std::get<I>(owned)->data()... };
+		std::tuple<ComponentArray<RawType<Observed>>*...> observed{
+			pool->template getArray<RawType<Observed>>()...
+		};
+
+		(markRange<Owned>(std::get<I>(owned), begin, end, tick), ...);
+
+		const Entity* groupEntities = std::get<0>(owned)->entities().data();
+
+		for (size_t i = begin; i < end; ++i) {
+			Entity e = groupEntities[i];
+			callback(
+				e,
+				static_cast<FetchType<Owned>&>(std::get<I>(ownedData)[i])...,
+				sparseComponent<Observed>(std::get<J>(observed), e, tick)...
+			);
+		}
+	}
+
+	template <typename Function, size_t... I>
+	void batchPacked(Function& callback, size_t begin, size_t end, std::index_sequence<I...>) {
+		if (begin >= end)
+			return;
+
+		std::tuple<ComponentArray<RawType<Owned>>*...> owned{ pool->template getArray<RawType<Owned>>()... };
+		(markRange<Owned>(std::get<I>(owned), begin, end, pool->changeTick), ...);
+
+		callback(
+			std::get<0>(owned)->entities().data() + begin,
+			end - begin,
+			static_cast<FetchType<Owned>*>(std::get<I>(owned)->data() + begin)...
+		);
+	}
+
+	template <typename Function>
+	void batchChunk(Archetype& archetype, size_t chunk, Function& callback) {
+		auto markColumn = [&]<typename Component>() {
+			if constexpr (!isReadOnly<Component>)
+				archetype.markChanged(chunk, componentID<RawType<Component>>(), pool->changeTick);
+		};
+
+		(markColumn.template operator()<Owned>(), ...);
+
+		callback(
+			static_cast<const Entity*>(archetype.entities(chunk)),
+			static_cast<size_t>(archetype.chunkSize(chunk)),
+			static_cast<FetchType<Owned>*>(archetype.template column<RawType<Owned>>(chunk))...
+		);
+	}
+
+	std::vector<std::pair<Archetype*, size_t>> matchingChunks(size_t& capacity) const {
+		ComponentMask mask = EntityPool::requiredMaskOf<Owned...>();
+		std::vector<std::pair<Archetype*, size_t>> chunks;
+
+		for (const auto& archetype : pool->archetypeStorage.getArchetypes()) {
+			if (!archetype->getMask().contains(mask))
+				continue;
+
+			capacity = std::max<size_t>(capacity, archetype->chunkCapacity());
+			for (size_t chunk = 0; chunk < archetype->chunkCount(); ++chunk)
+				chunks.emplace_back(archetype.get(), chunk);
+		}
+
+		return chunks;
+	}
+
+public:
+	Group(EntityPool* p, size_t groupIndex)
+		: pool(p)
+		, index(groupIndex)
+	{}
+
+	size_t size() const {
+		if (index != NO_GROUP)
+			return pool->groups[index].size;
+
+		ComponentMask mask = EntityPool::requiredMaskOf<Owned..., Observed...>();
+		size_t count = 0;
+
+		for (const auto& archetype : pool->archetypeStorage.getArchetypes()) {
+			if (archetype->getMask().contains(mask))
+				count += archetype->size();
+		}
+
+		return count;
+	}
+
+	template <typename Function>
+	void each(Function&& callback) {
+		if (index == NO_GROUP) {
+			pool->view<Owned..., Observed...>().each(callback);
+			return;
+		}
+
+		eachPacked(callback, 0, size(), std::index_sequence_for<Owned...>{}, std::index_sequence_for<Observed...>{});
+	}
+
+	// Calls callback(const Entity*, size_t count, Owned*...) over contiguous
+	// runs of owned components: the packed group range, or each matching
+	// archetype chunk. Meant for kernels working on whole arrays at once.
+	template <typename Function>
+	void eachBatch(Function&& callback) {
+		static_assert(sizeof...(Observed) == 0, "Batched iteration only covers owned components");
+
+		if (index != NO_GROUP) {
+			batchPacked(callback, 0, size(), std::index_sequence_for<Owned...>{});
+			return;
+		}
+
+		size_t capacity = 0;
+		for (auto& [archetype, chunk] : matchingChunks(capacity))
+			batchChunk(*archetype, chunk, callback);
+	}
+
+	template <typename Function>
+	void eachBatchParallel(Function&& callback, size_t grainSize = 0) {
+		static_assert(sizeof...(Observed) == 0, "Batched iteration only covers owned components");
+		JobSystem* jobs = pool->jobSystem;
+
+		if (!jobs) {
+			eachBatch(callback);
+			return;
+		}
+
+		if (index != NO_GROUP) {
+			jobs->parallelFor(size(), grainSize, [&](size_t begin, size_t end) {
+				batchPacked(callback, begin, end, std::index_sequence_for<Owned...>{});
+			});
+
+			return;
+		}
+
+		size_t capacity = 0;
+		auto chunks = matchingChunks(capacity);
+		size_t grain = grainSize ? grainSize : jobs->getGrainSize();
+
+		jobs->parallelFor(chunks.size(), std::max<size_t>(1, grain / std::max<size_t>(capacity, 1)), [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+				batchChunk(*chunks[i].first, chunks[i].second, callback);
+		});
+	}
+
+	template <typename Function>
+	void eachParallel(Function&& callback, size_t grainSize = 0) {
+		if (index == NO_GROUP) {
+			pool->view<Owned..., Observed...>().eachParallel(callback, grainSize);
+			return;
 		}
+
+		if (!pool->jobSystem) {
+			each(callback);
+			return;
+		}
+
+		pool->jobSystem->parallelFor(size(), grainSize, [&](size_t begin, size_t end) {
+			eachPacked(callback, begin, end, std::index_sequence_for<Owned...>{}, std::index_sequence_for<Observed...>{});
+		});
 	}
 };
 
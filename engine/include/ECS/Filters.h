@@ -0,0 +1,142 @@
+#pragma once
+
+#include <type_traits>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::ECS {
+
+// View filters: they narrow the matched entities but produce no callback
+// argument. Change filters compare against the tick of the system's last run
+// unless overridden with View::since(). With, Without and AnyOf are pure
+// mask tests, checked before any component is fetched; With is how views
+// require tags, which have nothing to fetch.
+template <typename Component>
+struct Changed {};
+
+template <typename Component>
+struct Added {};
+
+template <typename... Components>
+struct With {};
+
+template <typename... Components>
+struct Without {};
+
+template <typename... Components>
+struct AnyOf {};
+
+namespace Detail {
+
+template <typename T>
+struct FilterTraits {
+	static constexpr bool isFilter = false;
+	static constexpr bool isTracking = false;
+	static constexpr bool selects = false;
+};
+
+struct MaskFilter {
+	static constexpr bool isFilter = true;
+	static constexpr bool isTracking = false;
+	using Tracked = void;
+
+	// Whether the filter names components an entity must have; Without<>
+	// only excludes, so on its own it would match every entity.
+	static constexpr bool selects = false;
+
+	static ComponentMask requiredMask() { return {}; }
+	static ComponentMask excludedMask() { return {}; }
+	static ComponentMask anyMask() { return {}; }
+
+	// Calls function.template operator()<T>() for every component the filter
+	// requires, so a sparse view can walk the smallest of their arrays.
+	template <typename Function>
+	static void forEachRequired(Function&&) {}
+};
+
+template <typename Component>
+struct FilterTraits<Changed<Component>> : MaskFilter {
+	static constexpr bool isTracking = true;
+	static constexpr bool selects = true;
+	using Tracked = RawType<Component>;
+	static_assert(!isTag<Tracked>, "Tags have no change ticks");
+
+	static ComponentMask requiredMask() { return componentMask<Tracked>(); }
+	static bool passes(Uint32 addedTick, Uint32 changedTick, Uint32 since) { (void)addedTick; return changedTick > since; }
+};
+
+template <typename Component>
+struct FilterTraits<Added<Component>> : MaskFilter {
+	static constexpr bool isTracking = true;
+	static constexpr bool selects = true;
+	using Tracked = RawType<Component>;
+	static_assert(!isTag<Tracked>, "Tags have no change ticks");
+
+	static ComponentMask requiredMask() { return componentMask<Tracked>(); }
+	static bool passes(Uint32 addedTick, Uint32 changedTick, Uint32 since) { (void)changedTick; return addedTick > since; }
+};
+
+template <typename... Components>
+struct FilterTraits<With<Components...>> : MaskFilter {
+	static constexpr bool selects = true;
+
+	static ComponentMask requiredMask() { return (ComponentMask{} | ... | componentMask<RawType<Components>>()); }
+
+	template <typename Function>
+	static void forEachRequired(Function&& function) {
+		(function.template operator()<RawType<Components>>(), ...);
+	}
+};
+
+template <typename... Components>
+struct FilterTraits<Without<Components...>> : MaskFilter {
+	static ComponentMask excludedMask() { return (ComponentMask{} | ... | componentMask<RawType<Components>>()); }
+};
+
+template <typename... Components>
+struct FilterTraits<AnyOf<Components...>> : MaskFilter {
+	static constexpr bool selects = true;
+
+	static ComponentMask anyMask() { return (ComponentMask{} | ... | componentMask<RawType<Components>>()); }
+};
+
+// A view argument that narrows the match: a required fetch or a selecting
+// filter. Optional `T*` fetches never do.
+template <typename T>
+constexpr bool selectsEntities = FilterTraits<T>::selects || (!FilterTraits<T>::isFilter && !std::is_pointer_v<T>);
+
+template <typename List, typename T>
+struct Append;
+
+template <typename... Ts, typename T>
+struct Append<TypeList<Ts...>, T> {
+	using type = TypeList<Ts..., T>;
+};
+
+// Splits a view's template arguments into fetched components and filters.
+template <typename FetchList, typename FilterList, typename... Ts>
+struct Partition {
+	using Fetch = FetchList;
+	using Filter = FilterList;
+};
+
+template <typename FetchList, typename FilterList, typename T, typename... Rest>
+struct Partition<FetchList, FilterList, T, Rest...>
+	: std::conditional_t<FilterTraits<T>::isFilter,
+		Partition<FetchList, typename Append<FilterList, T>::type, Rest...>,
+		Partition<typename Append<FetchList, T>::type, FilterList, Rest...>> {};
+
+// Components fetched as `const T` (or `const T*`) don't mark the entity changed.
+template <typename Component>
+constexpr bool isReadOnly = std::is_const_v<std::remove_pointer_t<Component>>;
+
+template <typename Component>
+using FetchType = std::conditional_t<isReadOnly<Component>, const RawType<Component>, RawType<Component>>;
+
+// Tick of the running system's previous run; 0 outside of systems, so change
+// filters then match everything ever added or changed.
+inline thread_local Uint32 lastRunTick = 0;
+
+} // namespace Detail
+
+} // namespace Blackthorn::ECS
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "ECS/Components/Children.h"
+#include "ECS/Components/Parent.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/WorldTransform.h"
+#include "ECS/EntityPool.h"
+
+// Keeps Parent and Children consistent. Changing relationships through these
+// helpers marks the child's Transform changed so TransformSystem picks it up.
+namespace Blackthorn::ECS::Hierarchy {
+
+inline Entity parentOf(const EntityPool& pool, Entity entity) {
+	const Components::Parent* parent = pool.getComponent<Components::Parent>(entity);
+	return parent ? parent->entity : INVALID_ENTITY;
+}
+
+inline void assureWorldTransform(EntityPool& pool, Entity entity) {
+	if (pool.hasComponent<Components::WorldTransform>(entity))
+		return;
+
+	const Components::Transform* local = pool.getComponent<Components::Transform>(entity);
+	Components::WorldTransform world = local ? Components::WorldTransform(*local) : Components::WorldTransform();
+	pool.addComponent<Components::WorldTransform>(entity, world);
+}
+
+inline void detach(EntityPool& pool, Entity child) {
+	Entity parent = parentOf(pool, child);
+
+	if (parent == INVALID_ENTITY)
+		return;
+
+	if (auto* children = pool.getComponent<Components::Children>(parent)) {
+		auto& list = children->entities;
+		list.erase(std::remove(list.begin(), list.end(), child), list.end());
+	}
+
+	pool.removeComponent<Components::Parent>(child);
+	pool.markChanged<Components::Transform>(child);
+}
+
+inline void attach(EntityPool& pool, Entity child, Entity parent) {
+	if (!pool.isValid(child) || !pool.isValid(parent) || child == parent)
+		throw std::runtime_error("Hierarchy: Invalid attachment");
+
+	for (Entity ancestor = parent; ancestor != INVALID_ENTITY; ancestor = parentOf(pool, ancestor)) {
+		if (ancestor == child)
+			throw std::runtime_error("Hierarchy: Attachment would create a cycle");
+	}
+
+	detach(pool, child);
+
+	pool.addComponent<Components::Parent>(child, parent);
+	assureWorldTransform(pool, parent);
+	assureWorldTransform(pool, child);
+
+	if (!pool.hasComponent<Components::Children>(parent))
+		pool.addComponent<Components::Children>(parent);
+
+	pool.getComponent<Components::Children>(parent)->entities.push_back(child);
+	pool.markChanged<Components::Transform>(child);
+}
+
+inline void destroyRecursive(EntityPool& pool, Entity entity) {
+	if (!pool.isValid(entity))
+		return;
+
+	if (const auto* children = pool.getComponent<Components::Children>(entity)) {
+		std::vector<Entity> list = children->entities;
+		for (Entity child : list)
+			destroyRecursive(pool, child);
+	}
+
+	detach(pool, entity);
+	pool.destroy(entity);
+}
+
+} // namespace Blackthorn::ECS::Hierarchy
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "Core/Export.h"
 #include "ECS/Entity.h"
+#include "ECS/Snapshot.h"
 
 namespace Blackthorn::ECS {
 
@@ -14,6 +16,14 @@ public:
 	virtual bool has(Entity entity) const = 0;
 	virtual size_t size() const = 0;
 	virtual const std::vector<Entity>& entities() const = 0;
+	virtual Uint32 indexOf(Entity entity) const = 0;
+	virtual void swapEntries(Uint32 a, Uint32 b) = 0;
+	virtual void clear() = 0;
+	virtual void save(SnapshotWriter& writer) const = 0;
+	// Loaded rows count as added and changed at `tick`.
+	virtual void load(SnapshotReader& reader, Uint32 tick) = 0;
+	virtual std::unique_ptr<IComponentArray> clone() const = 0;
+	virtual std::unique_ptr<IComponentArray> create() const = 0;
 };
 
 } // namespace Blackthorn::ECS
\ No newline at end of file
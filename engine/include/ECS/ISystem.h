@@ -5,13 +5,46 @@
 
 namespace Blackthorn::ECS::Systems {
 
+struct SystemAccess {
+	Detail::ComponentMask reads;
+	Detail::ComponentMask writes;
+	bool exclusive = true;
+};
+
+template <typename... Components>
+struct Reads {};
+
+template <typename... Components>
+struct Writes {};
+
 class BLACKTHORN_API ISystem {
 public:
 	virtual ~ISystem() = default;
+
+	// Systems that do not declare their access are treated as exclusive and
+	// never share a scheduler stage with another system.
+	virtual SystemAccess getAccess() const { return SystemAccess{}; }
+	virtual const char* getName() const { return "System"; }
+
 	virtual void init(EntityPool*) {}
 	virtual void update(EntityPool*, float dt) {}
 	virtual void fixedUpdate(EntityPool*, float dt) {}
 	virtual void render(EntityPool*, float alpha) {}
 };
 
+template <typename ReadList, typename WriteList>
+class System;
+
+template <typename... Read, typename... Write>
+class System<Reads<Read...>, Writes<Write...>> : public ISystem {
+public:
+	SystemAccess getAccess() const override {
+		return SystemAccess{
+			(Detail::ComponentMask{} | ... | Detail::componentMask<Read>()),
+			(Detail::ComponentMask{} | ... | Detail::componentMask<Write>()),
+			false
+		};
+	}
+};
+
 } // namespace Blackthorn::ECS::Systems
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::ECS {
+
+class EntityPool;
+
+// Restore fires once after EntityPool::restoreSnapshot, with no entities,
+// since a restore raises no per-component events.
+enum class ObserverEvent : Uint8 {
+	Add,
+	Remove,
+	Replace,
+	Restore
+};
+
+// Immediate observers run inside the structural change itself, remove
+// observers before the component is gone. Deferred ones collect entities and
+// get them in one call at the next sync point (EntityPool::playbackCommands),
+// by which time removed entities may already be destroyed.
+enum class ObserverDelivery : Uint8 {
+	Immediate,
+	Deferred
+};
+
+using ObserverID = Uint32;
+constexpr ObserverID INVALID_OBSERVER = 0;
+
+using ObserverCallback = std::function<void(EntityPool&, std::span<const Entity>)>;
+
+namespace Detail {
+
+constexpr size_t OBSERVER_EVENT_COUNT = 4;
+
+struct Observer {
+	ObserverID id = INVALID_OBSERVER;
+	size_t component = 0;
+	ObserverEvent event = ObserverEvent::Add;
+	ObserverDelivery delivery = ObserverDelivery::Immediate;
+	ObserverCallback callback;
+	std::vector<Entity> pending;
+	std::vector<Entity> delivering;
+};
+
+} // namespace Detail
+
+} // namespace Blackthorn::ECS
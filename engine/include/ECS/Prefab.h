@@ -0,0 +1,136 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::ECS {
+
+class EntityPool;
+
+namespace Detail {
+
+class IPrefabComponent {
+public:
+	virtual ~IPrefabComponent() = default;
+	virtual std::unique_ptr<IPrefabComponent> clone() const = 0;
+	virtual void registerWith(EntityPool& pool) const = 0;
+	virtual void addTo(EntityPool& pool, std::span<const Entity> entities) const = 0;
+	virtual void fill(void* memory, size_t count) const = 0;
+};
+
+template <typename T>
+class PrefabComponent : public IPrefabComponent {
+private:
+	template <typename Pool>
+	void registerAll(Pool& pool) const {
+		pool.template registerComponent<T>();
+	}
+
+	template <typename Pool>
+	void addAll(Pool& pool, std::span<const Entity> entities) const {
+		pool.template addComponents<T>(entities, value);
+	}
+
+public:
+	T value;
+
+	template <typename... Args>
+	explicit PrefabComponent(Args&&... args)
+		: value(std::forward<Args>(args)...)
+	{}
+
+	std::unique_ptr<IPrefabComponent> clone() const override {
+		return std::make_unique<PrefabComponent<T>>(value);
+	}
+
+	void registerWith(EntityPool& pool) const override {
+		registerAll(pool);
+	}
+
+	void addTo(EntityPool& pool, std::span<const Entity> entities) const override {
+		addAll(pool, entities);
+	}
+
+	void fill(void* memory, size_t count) const override {
+		std::uninitialized_fill_n(static_cast<T*>(memory), count, value);
+	}
+};
+
+} // namespace Detail
+
+// Template of component values; EntityPool::instantiate() stamps out copies
+// with one bulk insert per component type instead of one per entity.
+class Prefab {
+private:
+	std::array<std::unique_ptr<Detail::IPrefabComponent>, Detail::MAX_COMPONENTS> components;
+	Detail::ComponentMask mask;
+
+	friend class EntityPool;
+
+public:
+	Prefab() = default;
+
+	Prefab(const Prefab& other)
+		: mask(other.mask)
+	{
+		for (size_t id = 0; id < components.size(); ++id) {
+			if (other.components[id])
+				components[id] = other.components[id]->clone();
+		}
+	}
+
+	Prefab& operator=(const Prefab& other) {
+		if (this != &other) {
+			Prefab copy(other);
+			*this = std::move(copy);
+		}
+
+		return *this;
+	}
+
+	Prefab(Prefab&&) noexcept = default;
+	Prefab& operator=(Prefab&&) noexcept = default;
+
+	template <typename Component, typename... Args>
+	Component& set(Args&&... args) {
+		size_t id = Detail::componentID<Component>();
+		auto component = std::make_unique<Detail::PrefabComponent<Component>>(std::forward<Args>(args)...);
+		Component& value = component->value;
+
+		components[id] = std::move(component);
+		mask |= Detail::componentMask<Component>();
+		return value;
+	}
+
+	template <typename Component>
+	void remove() {
+		components[Detail::componentID<Component>()].reset();
+		mask.reset(Detail::componentID<Component>());
+	}
+
+	template <typename Component>
+	bool has() const {
+		return mask.test(Detail::componentID<Component>());
+	}
+
+	template <typename Component>
+	Component* get() {
+		auto& component = components[Detail::componentID<Component>()];
+		return component ? &static_cast<Detail::PrefabComponent<Component>&>(*component).value : nullptr;
+	}
+
+	template <typename Component>
+	const Component* get() const {
+		const auto& component = components[Detail::componentID<Component>()];
+		return component ? &static_cast<const Detail::PrefabComponent<Component>&>(*component).value : nullptr;
+	}
+
+	const Detail::ComponentMask& getMask() const { return mask; }
+	bool empty() const { return mask.none(); }
+};
+
+} // namespace Blackthorn::ECS
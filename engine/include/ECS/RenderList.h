@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::ECS {
+
+// Entities in draw order, sorted by (layer, zOrder, texture) and kept sorted
+// across frames. Entries whose key changed are pulled out, sorted among
+// themselves and merged back in one linear pass, so a frame where nothing
+// changed costs nothing and one where k entries changed costs O(n + k log k).
+// Equal keys fall back to the entity, so the order never flickers.
+class RenderList {
+public:
+	struct Key {
+		Uint8 layer = 0;
+		float zOrder = 0.0f;
+		Uint32 texture = 0;
+
+		bool operator==(const Key&) const = default;
+	};
+
+private:
+	struct Entry {
+		Key key;
+		Entity entity = INVALID_ENTITY;
+	};
+
+	// Per entity index: the entity listed there and its current key.
+	struct Slot {
+		Entity entity = INVALID_ENTITY;
+		Key key;
+		bool pending = false;
+	};
+
+	std::vector<Slot> slots;
+	std::vector<Entry> entries;
+	std::vector<Entity> order;
+	std::vector<Uint32> changed;
+	std::vector<Entry> moved;
+	std::vector<Entry> merged;
+	bool stale = false;
+
+	static bool less(const Entry& a, const Entry& b) {
+		if (a.key.layer != b.key.layer)
+			return a.key.layer < b.key.layer;
+
+		if (a.key.zOrder != b.key.zOrder)
+			return a.key.zOrder < b.key.zOrder;
+
+		if (a.key.texture != b.key.texture)
+			return a.key.texture < b.key.texture;
+
+		return a.entity < b.entity;
+	}
+
+	void refresh() {
+		// Drop entries that were removed, replaced by a newer entity in the
+		// same slot, or are about to be merged back with a new key.
+		std::erase_if(entries, [this](const Entry& entry) {
+			const Slot& slot = slots[Detail::entityIndex(entry.entity)];
+			return slot.entity != entry.entity || slot.pending;
+		});
+
+		moved.clear();
+
+		for (Uint32 index : changed) {
+			Slot& slot = slots[index];
+
+			if (!slot.pending)
+				continue;
+
+			slot.pending = false;
+			moved.push_back(Entry{ slot.key, slot.entity });
+		}
+
+		changed.clear();
+		std::sort(moved.begin(), moved.end(), less);
+
+		merged.resize(entries.size() + moved.size());
+		std::merge(entries.begin(), entries.end(), moved.begin(), moved.end(), merged.begin(), less);
+		entries.swap(merged);
+
+		order.resize(entries.size());
+		for (size_t i = 0; i < entries.size(); ++i)
+			order[i] = entries[i].entity;
+
+		stale = false;
+	}
+
+public:
+	// Lists `entity` under `key`, or moves it if its key changed.
+	void assign(Entity entity, const Key& key) {
+		Uint32 index = Detail::entityIndex(entity);
+
+		if (index >= slots.size())
+			slots.resize(index + 1);
+
+		Slot& slot = slots[index];
+
+		if (slot.entity == entity && slot.key == key)
+			return;
+
+		slot.entity = entity;
+		slot.key = key;
+
+		if (!slot.pending) {
+			slot.pending = true;
+			changed.push_back(index);
+		}
+
+		stale = true;
+	}
+
+	void remove(Entity entity) {
+		Uint32 index = Detail::entityIndex(entity);
+
+		if (index >= slots.size() || slots[index].entity != entity)
+			return;
+
+		slots[index] = Slot{};
+		stale = true;
+	}
+
+	bool contains(Entity entity) const {
+		Uint32 index = Detail::entityIndex(entity);
+		return index < slots.size() && slots[index].entity == entity;
+	}
+
+	void clear() {
+		slots.clear();
+		entries.clear();
+		order.clear();
+		changed.clear();
+		stale = false;
+	}
+
+	// Entities back to front. Valid until the list is next changed.
+	std::span<const Entity> sorted() {
+		if (stale)
+			refresh();
+
+		return order;
+	}
+};
+
+} // namespace Blackthorn::ECS
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::ECS {
+
+// Contiguous binary image of an EntityPool. The buffer is kept between
+// saves, so re-snapshotting a world of steady size doesn't allocate.
+class Snapshot {
+private:
+	std::unique_ptr<std::byte[]> storage;
+	size_t used = 0;
+	size_t capacity = 0;
+
+	friend class SnapshotWriter;
+
+public:
+	Snapshot() = default;
+
+	Snapshot(const Snapshot& other) {
+		assign(other.data(), other.size());
+	}
+
+	Snapshot& operator=(const Snapshot& other) {
+		if (this != &other)
+			assign(other.data(), other.size());
+
+		return *this;
+	}
+
+	Snapshot(Snapshot&&) noexcept = default;
+	Snapshot& operator=(Snapshot&&) noexcept = default;
+
+	void reserve(size_t bytes) {
+		if (bytes <= capacity)
+			return;
+
+		size_t newCapacity = std::max(bytes, capacity * 2);
+		std::unique_ptr<std::byte[]> grown(new std::byte[newCapacity]);
+
+		if (used)
+			std::memcpy(grown.get(), storage.get(), used);
+
+		storage = std::move(grown);
+		capacity = newCapacity;
+	}
+
+	void assign(const void* bytes, size_t count) {
+		used = 0;
+		reserve(count);
+
+		if (count)
+			std::memcpy(storage.get(), bytes, count);
+
+		used = count;
+	}
+
+	void clear() { used = 0; }
+	bool empty() const { return used == 0; }
+
+	const std::byte* data() const { return storage.get(); }
+	size_t size() const { return used; }
+};
+
+class SnapshotWriter {
+private:
+	Snapshot& snapshot;
+
+public:
+	explicit SnapshotWriter(Snapshot& target)
+		: snapshot(target)
+	{}
+
+	void write(const void* data, size_t bytes) {
+		if (!bytes)
+			return;
+
+		snapshot.reserve(snapshot.used + bytes);
+		std::memcpy(snapshot.storage.get() + snapshot.used, data, bytes);
+		snapshot.used += bytes;
+	}
+
+	template <typename T>
+	void write(const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written directly");
+		write(&value, sizeof(T));
+	}
+};
+
+class SnapshotReader {
+private:
+	const std::byte* data;
+	size_t size;
+	size_t offset = 0;
+
+public:
+	explicit SnapshotReader(const Snapshot& snapshot)
+		: data(snapshot.data())
+		, size(snapshot.size())
+	{}
+
+	void read(void* out, size_t bytes) {
+		if (!bytes)
+			return;
+
+		if (bytes > size - offset)
+			throw std::runtime_error("Snapshot: Unexpected end of data");
+
+		std::memcpy(out, data + offset, bytes);
+		offset += bytes;
+	}
+
+	// Reads an element count, refusing one the remaining bytes can't hold.
+	size_t readCount(size_t elementBytes) {
+		size_t count = read<Uint64>();
+
+		if (elementBytes && count > (size - offset) / elementBytes)
+			throw std::runtime_error("Snapshot: Unexpected end of data");
+
+		return count;
+	}
+
+	template <typename T>
+	T read() {
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read directly");
+		T value;
+		read(&value, sizeof(T));
+		return value;
+	}
+};
+
+// Components that aren't trivially copyable need a specialization providing
+//   static void save(const T&, SnapshotWriter&);
+//   static T load(SnapshotReader&);
+// A specialization also takes over from the plain copy for trivially
+// copyable types whose bytes don't mean the same in another process, like
+// handles into a process-wide table.
+template <typename T>
+struct Serializer {};
+
+namespace Detail {
+
+constexpr Uint32 SNAPSHOT_MAGIC = 0x4E534254; // "BTSN"
+constexpr Uint32 SNAPSHOT_VERSION = 2;
+
+template <typename T>
+concept HasSerializer = requires(const T& component, SnapshotWriter& writer, SnapshotReader& reader) {
+	Serializer<T>::save(component, writer);
+	{ Serializer<T>::load(reader) } -> std::same_as<T>;
+};
+
+template <typename T>
+constexpr bool isSnapshotable = std::is_trivially_copyable_v<T> || HasSerializer<T>;
+
+[[noreturn]] inline void missingSerializer() {
+	throw std::runtime_error("Snapshot: Component is not trivially copyable and has no Serializer");
+}
+
+template <typename T>
+void saveComponents(const T* components, size_t count, SnapshotWriter& writer) {
+	if constexpr (HasSerializer<T>) {
+		for (size_t i = 0; i < count; ++i)
+			Serializer<T>::save(components[i], writer);
+	} else if constexpr (std::is_trivially_copyable_v<T>) {
+		writer.write(components, count * sizeof(T));
+	} else {
+		(void)components;
+		(void)count;
+		(void)writer;
+		missingSerializer();
+	}
+}
+
+// Constructs `count` components into raw storage.
+template <typename T>
+void loadComponents(void* memory, size_t count, SnapshotReader& reader) {
+	if constexpr (HasSerializer<T>) {
+		T* components = static_cast<T*>(memory);
+		for (size_t i = 0; i < count; ++i)
+			new (components + i) T(Serializer<T>::load(reader));
+	} else if constexpr (std::is_trivially_copyable_v<T>) {
+		reader.read(memory, count * sizeof(T));
+	} else {
+		(void)memory;
+		(void)count;
+		(void)reader;
+		missingSerializer();
+	}
+}
+
+[[noreturn]] inline void layoutMismatch() {
+	throw std::runtime_error("Snapshot: Component layout differs from the one saved");
+}
+
+// Per array or column: which type it holds and how big one is, checked on
+// load so a snapshot from a build with a different layout is refused.
+inline void writeTypeHeader(SnapshotWriter& writer, TypeHash hash, size_t size) {
+	writer.write(hash);
+	writer.write(static_cast<Uint64>(size));
+}
+
+inline void checkTypeHeader(SnapshotReader& reader, TypeHash hash, size_t size) {
+	if (reader.read<TypeHash>() != hash || reader.read<Uint64>() != size)
+		layoutMismatch();
+}
+
+// Component ids are handed out in first-use order, so they differ between
+// processes. A snapshot starts with the type hash of every id it may use;
+// this maps those ids, and masks built from them, to the local ones.
+class TypeRemap {
+private:
+	std::array<size_t, MAX_COMPONENTS> local;
+	size_t count = 0;
+	bool identity = true;
+
+public:
+	static void write(SnapshotWriter& writer) {
+		const TypeRegistry& registry = TypeRegistry::global();
+		Uint32 types = static_cast<Uint32>(registry.size());
+
+		writer.write(types);
+		for (Uint32 id = 0; id < types; ++id)
+			writer.write(registry.hash(id));
+	}
+
+	void read(SnapshotReader& reader) {
+		count = reader.read<Uint32>();
+
+		if (count > MAX_COMPONENTS)
+			throw std::runtime_error("Snapshot: More component types than BLACKTHORN_MAX_COMPONENTS");
+
+		// Types the snapshot knows but this process never used only fail
+		// once something actually refers to them.
+		for (size_t id = 0; id < count; ++id) {
+			local[id] = TypeRegistry::global().find(reader.read<TypeHash>());
+			identity = identity && local[id] == id;
+		}
+	}
+
+	size_t operator()(size_t id) const {
+		if (id >= count || local[id] == TypeRegistry::NO_TYPE)
+			throw std::runtime_error("Snapshot: Component type not registered with this pool");
+
+		return local[id];
+	}
+
+	ComponentMask operator()(const ComponentMask& mask) const {
+		if (identity)
+			return mask;
+
+		ComponentMask mapped;
+		mask.forEach([&](size_t id) { mapped.set((*this)(id)); });
+		return mapped;
+	}
+};
+
+} // namespace Detail
+
+// Fixed ring of snapshots keyed by frame number, for rollback: save every
+// simulated frame, restore the one a late input belongs to and re-simulate.
+class SnapshotHistory {
+private:
+	static constexpr Uint64 NO_FRAME = UINT64_MAX;
+
+	std::vector<Snapshot> slots;
+	std::vector<Uint64> frames;
+
+public:
+	explicit SnapshotHistory(size_t capacity = 8)
+		: slots(std::max<size_t>(capacity, 1))
+		, frames(slots.size(), NO_FRAME)
+	{}
+
+	// Slot to save `frame` into, overwriting the oldest one.
+	Snapshot& record(Uint64 frame) {
+		size_t slot = frame % slots.size();
+		frames[slot] = frame;
+		slots[slot].clear();
+		return slots[slot];
+	}
+
+	const Snapshot* find(Uint64 frame) const {
+		size_t slot = frame % slots.size();
+		return frames[slot] == frame ? &slots[slot] : nullptr;
+	}
+
+	size_t capacity() const { return slots.size(); }
+
+	void clear() {
+		std::fill(frames.begin(), frames.end(), NO_FRAME);
+	}
+};
+
+} // namespace Blackthorn::ECS
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::ECS {
+
+// Uniform grid over entity AABBs. An entity is listed in every cell its box
+// overlaps. Queries return spans into an internal buffer that stays valid
+// until the next query; buffers are reused, so steady-state queries don't
+// allocate. Queries are not safe to run concurrently on one grid.
+class SpatialGrid {
+private:
+	static constexpr Uint32 NOT_INDEXED = UINT32_MAX;
+
+	struct CellRange {
+		Sint32 minX = 0;
+		Sint32 minY = 0;
+		Sint32 maxX = -1;
+		Sint32 maxY = -1;
+
+		bool operator==(const CellRange&) const = default;
+	};
+
+	struct Entry {
+		Entity entity = INVALID_ENTITY;
+		Uint32 slot = NOT_INDEXED;
+		glm::vec2 min{0, 0};
+		glm::vec2 max{0, 0};
+		CellRange cells;
+	};
+
+	float cellSize;
+	float inverseCellSize;
+
+	std::unordered_map<Uint64, std::vector<Entity>> cells;
+	std::vector<Entry> entries;
+	std::vector<Entity> indexed;
+	CellRange occupied;
+
+	std::vector<Entity> results;
+	std::vector<std::pair<float, Entity>> candidates;
+	std::vector<Uint32> visitMarks;
+	Uint32 visitMark = 0;
+
+	static Uint64 cellKey(Sint32 x, Sint32 y) {
+		return (static_cast<Uint64>(static_cast<Uint32>(x)) << 32) | static_cast<Uint32>(y);
+	}
+
+	Sint32 cellCoord(float value) const {
+		return static_cast<Sint32>(std::floor(value * inverseCellSize));
+	}
+
+	CellRange rangeOf(glm::vec2 min, glm::vec2 max) const {
+		return CellRange{ cellCoord(min.x), cellCoord(min.y), cellCoord(max.x), cellCoord(max.y) };
+	}
+
+	CellRange clampToOccupied(CellRange range) const {
+		return CellRange{
+			std::max(range.minX, occupied.minX),
+			std::max(range.minY, occupied.minY),
+			std::min(range.maxX, occupied.maxX),
+			std::min(range.maxY, occupied.maxY)
+		};
+	}
+
+	void link(Entity entity, const CellRange& range) {
+		for (Sint32 y = range.minY; y <= range.maxY; ++y) {
+			for (Sint32 x = range.minX; x <= range.maxX; ++x)
+				cells[cellKey(x, y)].push_back(entity);
+		}
+
+		if (occupied.maxX < occupied.minX) {
+			occupied = range;
+			return;
+		}
+
+		occupied.minX = std::min(occupied.minX, range.minX);
+		occupied.minY = std::min(occupied.minY, range.minY);
+		occupied.maxX = std::max(occupied.maxX, range.maxX);
+		occupied.maxY = std::max(occupied.maxY, range.maxY);
+	}
+
+	// Emptied cells keep their storage so entities moving back don't allocate.
+	void unlink(Entity entity, const CellRange& range) {
+		for (Sint32 y = range.minY; y <= range.maxY; ++y) {
+			for (Sint32 x = range.minX; x <= range.maxX; ++x) {
+				auto it = cells.find(cellKey(x, y));
+				if (it == cells.end())
+					continue;
+
+				auto& list = it->second;
+				auto pos = std::find(list.begin(), list.end(), entity);
+
+				if (pos != list.end()) {
+					*pos = list.back();
+					list.pop_back();
+				}
+			}
+		}
+	}
+
+	Entry* entryOf(Entity entity) {
+		Uint32 index = Detail::entityIndex(entity);
+
+		if (index >= entries.size() || entries[index].entity != entity || entries[index].slot == NOT_INDEXED)
+			return nullptr;
+
+		return &entries[index];
+	}
+
+	// Returns false if the entity was already seen by the current query.
+	bool visit(Entity entity) {
+		Uint32 index = Detail::entityIndex(entity);
+
+		if (visitMarks[index] == visitMark)
+			return false;
+
+		visitMarks[index] = visitMark;
+		return true;
+	}
+
+	void beginQuery() {
+		results.clear();
+
+		if (visitMarks.size() < entries.size())
+			visitMarks.resize(entries.size(), 0);
+
+		if (++visitMark == 0) {
+			std::fill(visitMarks.begin(), visitMarks.end(), 0);
+			visitMark = 1;
+		}
+	}
+
+	template <typename Function>
+	void forEachInRange(const CellRange& range, Function&& function) {
+		for (Sint32 y = range.minY; y <= range.maxY; ++y) {
+			for (Sint32 x = range.minX; x <= range.maxX; ++x) {
+				auto it = cells.find(cellKey(x, y));
+				if (it == cells.end())
+					continue;
+
+				for (Entity entity : it->second) {
+					if (visit(entity))
+						function(entries[Detail::entityIndex(entity)]);
+				}
+			}
+		}
+	}
+
+	static float distanceSquared(const Entry& entry, glm::vec2 point) {
+		float dx = std::max({ entry.min.x - point.x, 0.0f, point.x - entry.max.x });
+		float dy = std::max({ entry.min.y - point.y, 0.0f, point.y - entry.max.y });
+		return dx * dx + dy * dy;
+	}
+
+public:
+	explicit SpatialGrid(float cell = 128.0f)
+		: cellSize(cell)
+		, inverseCellSize(1.0f / cell)
+	{}
+
+	void insert(Entity entity, glm::vec2 min, glm::vec2 max) {
+		Uint32 index = Detail::entityIndex(entity);
+
+		if (index >= entries.size())
+			entries.resize(index + 1);
+
+		Entry& entry = entries[index];
+
+		if (entry.slot != NOT_INDEXED && entry.entity != entity)
+			remove(entry.entity);
+
+		CellRange range = rangeOf(min, max);
+
+		if (entry.slot == NOT_INDEXED) {
+			entry.entity = entity;
+			entry.slot = static_cast<Uint32>(indexed.size());
+			indexed.push_back(entity);
+			link(entity, range);
+		} else if (!(entry.cells == range)) {
+			unlink(entity, entry.cells);
+			link(entity, range);
+		}
+
+		entry.min = min;
+		entry.max = max;
+		entry.cells = range;
+	}
+
+	void remove(Entity entity) {
+		Entry* entry = entryOf(entity);
+
+		if (!entry)
+			return;
+
+		unlink(entity, entry->cells);
+
+		Entity moved = indexed.back();
+		indexed[entry->slot] = moved;
+		entries[Detail::entityIndex(moved)].slot = entry->slot;
+		indexed.pop_back();
+
+		entry->slot = NOT_INDEXED;
+		entry->entity = INVALID_ENTITY;
+	}
+
+	bool contains(Entity entity) {
+		return entryOf(entity) != nullptr;
+	}
+
+	void clear() {
+		for (auto& [key, list] : cells)
+			list.clear();
+
+		for (Entity entity : indexed)
+			entries[Detail::entityIndex(entity)] = Entry{};
+
+		indexed.clear();
+		occupied = CellRange{};
+	}
+
+	std::span<const Entity> queryAABB(glm::vec2 min, glm::vec2 max) {
+		beginQuery();
+
+		forEachInRange(clampToOccupied(rangeOf(min, max)), [&](const Entry& entry) {
+			if (entry.min.x <= max.x && entry.max.x >= min.x && entry.min.y <= max.y && entry.max.y >= min.y)
+				results.push_back(entry.entity);
+		});
+
+		return results;
+	}
+
+	std::span<const Entity> queryRadius(glm::vec2 center, float radius) {
+		beginQuery();
+
+		float radiusSquared = radius * radius;
+		CellRange range = rangeOf(center - glm::vec2(radius), center + glm::vec2(radius));
+
+		forEachInRange(clampToOccupied(range), [&](const Entry& entry) {
+			if (distanceSquared(entry, center) <= radiusSquared)
+				results.push_back(entry.entity);
+		});
+
+		return results;
+	}
+
+	// Up to `count` entities ordered by distance from `point` to their box.
+	// Searches rings of cells outward and stops once no unvisited cell can
+	// hold anything closer than the current k-th candidate.
+	std::span<const Entity> queryNearest(glm::vec2 point, size_t count) {
+		beginQuery();
+		candidates.clear();
+
+		if (count == 0 || indexed.empty())
+			return results;
+
+		Sint32 cx = cellCoord(point.x);
+		Sint32 cy = cellCoord(point.y);
+		Sint32 maxRing = std::max({
+			cx - occupied.minX, occupied.maxX - cx,
+			cy - occupied.minY, occupied.maxY - cy,
+			0
+		});
+
+		auto collect = [&](const Entry& entry) {
+			candidates.emplace_back(distanceSquared(entry, point), entry.entity);
+		};
+
+		for (Sint32 ring = 0; ring <= maxRing; ++ring) {
+			if (ring == 0) {
+				forEachInRange(CellRange{ cx, cy, cx, cy }, collect);
+			} else {
+				forEachInRange(CellRange{ cx - ring, cy - ring, cx + ring, cy - ring }, collect);
+				forEachInRange(CellRange{ cx - ring, cy + ring, cx + ring, cy + ring }, collect);
+				forEachInRange(CellRange{ cx - ring, cy - ring + 1, cx - ring, cy + ring - 1 }, collect);
+				forEachInRange(CellRange{ cx + ring, cy - ring + 1, cx + ring, cy + ring - 1 }, collect);
+			}
+
+			if (candidates.size() < count)
+				continue;
+
+			std::nth_element(candidates.begin(), candidates.begin() + (count - 1), candidates.end());
+			float reach = ring * cellSize;
+
+			if (candidates[count - 1].first <= reach * reach)
+				break;
+		}
+
+		size_t found = std::min(count, candidates.size());
+		std::partial_sort(candidates.begin(), candidates.begin() + found, candidates.end());
+
+		for (size_t i = 0; i < found; ++i)
+			results.push_back(candidates[i].second);
+
+		return results;
+	}
+
+	float getCellSize() const { return cellSize; }
+	size_t size() const { return indexed.size(); }
+	const std::vector<Entity>& getEntities() const { return indexed; }
+};
+
+} // namespace Blackthorn::ECS
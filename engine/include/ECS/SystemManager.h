@@ -1,17 +1,154 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <vector>
 
 #include "Core/Export.h"
+#include "Debug/Profiler.h"
 #include "ECS/ISystem.h"
 
 namespace Blackthorn::ECS::Systems {
 
+struct SystemTiming {
+	const char* name = nullptr;
+	Uint64 startTime = 0;
+	Uint64 endTime = 0;
+	size_t stage = 0;
+};
+
 class BLACKTHORN_API SystemManager {
 private:
+	enum Phase : size_t {
+		UpdatePhase,
+		FixedUpdatePhase,
+		RenderPhase,
+		PhaseCount
+	};
+
+	// Change tick at the end of the system's last run, per phase; it's what
+	// Changed/Added view filters compare against while the system runs.
+	struct SystemEntry {
+		std::unique_ptr<ISystem> system;
+		std::array<Uint32, PhaseCount> lastRunTicks{};
+	};
+
+	// Points Detail::lastRunTick at one system's last run for the scope, then
+	// restores the outer value, even if the system throws. Restored rather
+	// than zeroed: a worker waiting inside one world's system may run a
+	// system of another world in between.
+	class LastRunTickScope {
+	private:
+		Uint32 outerTick;
+
+	public:
+		explicit LastRunTickScope(Uint32 tick)
+			: outerTick(Detail::lastRunTick)
+		{
+			Detail::lastRunTick = tick;
+		}
+
+		~LastRunTickScope() { Detail::lastRunTick = outerTick; }
+
+		LastRunTickScope(const LastRunTickScope&) = delete;
+		LastRunTickScope& operator=(const LastRunTickScope&) = delete;
+	};
+
 	EntityPool& pool;
-	std::vector<std::unique_ptr<ISystem>> systems;
+	std::vector<SystemEntry> systems;
+	std::vector<std::vector<size_t>> stages;
+	std::vector<SystemTiming> timings;
+
+	static bool conflicts(const SystemAccess& a, const SystemAccess& b) {
+		if (a.exclusive || b.exclusive)
+			return true;
+
+		return a.writes.intersects(b.reads | b.writes) || b.writes.intersects(a.reads);
+	}
+
+	void buildStages() {
+		std::vector<SystemAccess> access;
+		std::vector<size_t> levels(systems.size(), 0);
+		access.reserve(systems.size());
+
+		for (size_t i = 0; i < systems.size(); ++i) {
+			access.push_back(systems[i].system->getAccess());
+
+			for (size_t j = 0; j < i; ++j) {
+				if (conflicts(access[i], access[j]))
+					levels[i] = std::max(levels[i], levels[j] + 1);
+			}
+		}
+
+		stages.clear();
+		for (size_t i = 0; i < systems.size(); ++i) {
+			if (levels[i] >= stages.size())
+				stages.resize(levels[i] + 1);
+
+			stages[levels[i]].push_back(i);
+		}
+	}
+
+	template <typename Function>
+	void runSystem(size_t index, size_t stage, Phase phase, Uint32 tick, Function& function) {
+		SystemEntry& entry = systems[index];
+		Uint64 start = SDL_GetPerformanceCounter();
+
+		{
+			LastRunTickScope scope(entry.lastRunTicks[phase]);
+			function(*entry.system);
+		}
+
+		entry.lastRunTicks[phase] = tick;
+
+		timings[index] = SystemTiming{ entry.system->getName(), start, SDL_GetPerformanceCounter(), stage };
+	}
+
+	template <typename Function>
+	void runPhase(Phase phase, Function function, bool parallel) {
+		buildStages();
+		timings.assign(systems.size(), SystemTiming{});
+
+		JobSystem* jobs = parallel ? pool.getJobSystem() : nullptr;
+
+		for (size_t stage = 0; stage < stages.size(); ++stage) {
+			const auto& members = stages[stage];
+			Uint32 tick = pool.advanceTick();
+
+			if (!jobs || jobs->getWorkerCount() == 0 || members.size() == 1) {
+				for (size_t index : members)
+					runSystem(index, stage, phase, tick, function);
+
+				continue;
+			}
+
+			JobCounter counter;
+			for (size_t i = 1; i < members.size(); ++i) {
+				size_t index = members[i];
+				jobs->submit(counter, [this, index, stage, phase, tick, &function]() {
+					runSystem(index, stage, phase, tick, function);
+				});
+			}
+
+			try {
+				runSystem(members.front(), stage, phase, tick, function);
+			} catch (...) {
+				jobs->wait(counter);
+				throw;
+			}
+
+			jobs->wait(counter);
+		}
+
+		// Changes made between phases get a tick newer than any system's last run.
+		pool.advanceTick();
+
+		#ifdef BLACKTHORN_DEBUG
+			auto& profiler = Debug::Profiler::instance();
+			for (const auto& timing : timings)
+				profiler.recordSample(timing.name, timing.startTime, timing.endTime);
+		#endif
+	}
 
 public:
 	explicit SystemManager(EntityPool& p)
@@ -25,7 +162,7 @@ public:
 		auto system = std::make_unique<System>(std::forward<Args>(args)...);
 		System* ptr = system.get();
 		ptr->init(&pool);
-		systems.push_back(std::move(system));
+		systems.push_back(SystemEntry{ std::move(system) });
 		return ptr;
 	}
 
@@ -34,13 +171,13 @@ public:
 		auto it = std::find_if(
 			systems.begin(),
 			systems.end(),
-			[](const std::unique_ptr<ISystem>& system) {
-				return dynamic_cast<System*>(system.get()) != nullptr;
+			[](const SystemEntry& entry) {
+				return dynamic_cast<System*>(entry.system.get()) != nullptr;
 			}
 		);
 
 		if (it != systems.end())
-			return dynamic_cast<System*>(it->get());
+			return dynamic_cast<System*>(it->system.get());
 
 		return nullptr;
 	}
@@ -50,8 +187,8 @@ public:
 		auto it = std::remove_if(
 			systems.begin(),
 			systems.end(),
-			[](const std::unique_ptr<ISystem>& system) {
-				return dynamic_cast<System*>(system.get()) != nullptr;
+			[](const SystemEntry& entry) {
+				return dynamic_cast<System*>(entry.system.get()) != nullptr;
 			}
 		);
 
@@ -60,19 +197,21 @@ public:
 	}
 
 	void update(float dt) {
-		for (auto& system: systems)
-			system->update(&pool, dt);
+		runPhase(UpdatePhase, [this, dt](ISystem& system) { system.update(&pool, dt); }, true);
+		pool.playbackCommands();
 	}
 
 	void fixedUpdate(float dt) {
-		for (auto& system: systems)
-			system->fixedUpdate(&pool, dt);
+		runPhase(FixedUpdatePhase, [this, dt](ISystem& system) { system.fixedUpdate(&pool, dt); }, true);
+		pool.playbackCommands();
 	}
 
 	void render(float alpha) {
-		for (auto& system: systems)
-			system->render(&pool, alpha);
+		runPhase(RenderPhase, [this, alpha](ISystem& system) { system.render(&pool, alpha); }, false);
 	}
+
+	const std::vector<std::vector<size_t>>& getStages() const { return stages; }
+	const std::vector<SystemTiming>& getTimings() const { return timings; }
 };
 
 } // namespace Blackthorn::ECS::Systems
\ No newline at end of file
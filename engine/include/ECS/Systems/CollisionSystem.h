@@ -0,0 +1,352 @@
+#pragma once
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ECS/Components/Collider.h"
+#include "ECS/Components/Kinematics.h"
+#include "ECS/Components/Parent.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/WorldTransform.h"
+#include "ECS/ISystem.h"
+
+namespace Blackthorn::ECS::Systems {
+
+// `normal` points from `a` to `b`; moving them `depth` apart along it
+// separates the shapes.
+struct Contact {
+	Entity a = INVALID_ENTITY;
+	Entity b = INVALID_ENTITY;
+	glm::vec2 normal{0, 0};
+	float depth = 0.0f;
+	bool isTrigger = false;
+};
+
+// Finds overlapping Colliders every fixed step and pushes dynamic bodies
+// (Kinematics, no Parent) out of each other and out of static ones. The
+// broadphase sweeps bounds sorted on x; the narrowphase runs SAT for boxes
+// and closest-point tests for circles. Moving only the position lets Verlet
+// integration derive the bounce. Contacts stay readable until the next step.
+class BLACKTHORN_API CollisionSystem : public System<
+	Reads<Components::Collider, Components::Kinematics, Components::Parent, Components::WorldTransform>,
+	Writes<Components::Transform>
+> {
+private:
+	using Shape = Components::Collider::Shape;
+
+	struct Body {
+		Entity entity = INVALID_ENTITY;
+		Shape shape = Shape::AABB;
+		glm::vec2 center{0, 0};
+		glm::vec2 halfExtents{0, 0};
+		glm::vec2 axisX{1, 0};
+		glm::vec2 axisY{0, 1};
+		glm::vec2 min{0, 0};
+		glm::vec2 max{0, 0};
+		float radius = 0.0f;
+		Uint32 layer = 0;
+		Uint32 mask = 0;
+		bool isDynamic = false;
+		bool isTrigger = false;
+	};
+
+	std::vector<Body> bodies;
+	std::vector<Uint32> order;
+
+	// Bounds in sweep order, split so the sweep only streams the floats it compares.
+	std::vector<float> minX;
+	std::vector<float> maxX;
+	std::vector<float> minY;
+	std::vector<float> maxY;
+
+	std::vector<std::pair<Uint32, Uint32>> pairs;
+	std::vector<Contact> contacts;
+	std::vector<std::pair<Uint32, Uint32>> contactBodies;
+
+	static Body makeBody(Entity entity, const Components::Collider& collider, glm::vec2 position, float angle, float scale, bool isDynamic) {
+		Body body;
+		body.entity = entity;
+		body.shape = collider.shape;
+		body.layer = collider.layer;
+		body.mask = collider.mask;
+		body.isDynamic = isDynamic;
+		body.isTrigger = collider.isTrigger;
+
+		float c = std::cos(angle);
+		float s = std::sin(angle);
+		glm::vec2 offset = collider.offset * scale;
+		body.center = position + glm::vec2(offset.x * c - offset.y * s, offset.x * s + offset.y * c);
+
+		if (collider.shape == Shape::Circle) {
+			body.radius = std::abs(collider.radius * scale);
+			body.min = body.center - glm::vec2(body.radius);
+			body.max = body.center + glm::vec2(body.radius);
+			return body;
+		}
+
+		body.halfExtents = glm::abs(collider.halfExtents * scale);
+
+		if (collider.shape == Shape::OBB) {
+			body.axisX = { c, s };
+			body.axisY = { -s, c };
+		}
+
+		glm::vec2 extent = glm::abs(body.axisX) * body.halfExtents.x + glm::abs(body.axisY) * body.halfExtents.y;
+		body.min = body.center - extent;
+		body.max = body.center + extent;
+		return body;
+	}
+
+	static bool canCollide(const Body& a, const Body& b) {
+		if (!a.isDynamic && !b.isDynamic && !a.isTrigger && !b.isTrigger)
+			return false;
+
+		return (a.layer & b.mask) && (b.layer & a.mask);
+	}
+
+	static float projectedRadius(const Body& box, glm::vec2 axis) {
+		return box.halfExtents.x * std::abs(glm::dot(box.axisX, axis)) + box.halfExtents.y * std::abs(glm::dot(box.axisY, axis));
+	}
+
+	static bool circleCircle(const Body& a, const Body& b, Contact& contact) {
+		glm::vec2 d = b.center - a.center;
+		float reach = a.radius + b.radius;
+		float distanceSquared = glm::dot(d, d);
+
+		if (distanceSquared >= reach * reach)
+			return false;
+
+		float distance = std::sqrt(distanceSquared);
+		contact.normal = distance > 0.0f ? d / distance : glm::vec2(1, 0);
+		contact.depth = reach - distance;
+		return true;
+	}
+
+	// Normal points from the box to the circle.
+	static bool boxCircle(const Body& box, const Body& circle, Contact& contact) {
+		glm::vec2 d = circle.center - box.center;
+		glm::vec2 local{ glm::dot(d, box.axisX), glm::dot(d, box.axisY) };
+		glm::vec2 closest = glm::clamp(local, -box.halfExtents, box.halfExtents);
+
+		if (closest != local) {
+			glm::vec2 delta = local - closest;
+			float distanceSquared = glm::dot(delta, delta);
+
+			if (distanceSquared >= circle.radius * circle.radius)
+				return false;
+
+			float distance = std::sqrt(distanceSquared);
+			glm::vec2 n = delta / distance;
+			contact.normal = box.axisX * n.x + box.axisY * n.y;
+			contact.depth = circle.radius - distance;
+			return true;
+		}
+
+		// Center inside the box: leave through the nearest face.
+		glm::vec2 gap = box.halfExtents - glm::abs(local);
+
+		if (gap.x < gap.y) {
+			contact.normal = local.x < 0.0f ? -box.axisX : box.axisX;
+			contact.depth = gap.x + circle.radius;
+		} else {
+			contact.normal = local.y < 0.0f ? -box.axisY : box.axisY;
+			contact.depth = gap.y + circle.radius;
+		}
+
+		return true;
+	}
+
+	// Separating axis test; two AABBs share their axes, so only two are tried.
+	static bool boxBox(const Body& a, const Body& b, Contact& contact) {
+		glm::vec2 d = b.center - a.center;
+		const glm::vec2 axes[4] = { a.axisX, a.axisY, b.axisX, b.axisY };
+		size_t axisCount = (a.shape == Shape::AABB && b.shape == Shape::AABB) ? 2 : 4;
+
+		contact.depth = FLT_MAX;
+
+		for (size_t i = 0; i < axisCount; ++i) {
+			float distance = glm::dot(d, axes[i]);
+			float overlap = projectedRadius(a, axes[i]) + projectedRadius(b, axes[i]) - std::abs(distance);
+
+			if (overlap <= 0.0f)
+				return false;
+
+			if (overlap < contact.depth) {
+				contact.depth = overlap;
+				contact.normal = distance < 0.0f ? -axes[i] : axes[i];
+			}
+		}
+
+		return true;
+	}
+
+	static bool collide(const Body& a, const Body& b, Contact& contact) {
+		bool aCircle = a.shape == Shape::Circle;
+		bool bCircle = b.shape == Shape::Circle;
+
+		if (aCircle && bCircle)
+			return circleCircle(a, b, contact);
+
+		if (bCircle)
+			return boxCircle(a, b, contact);
+
+		if (aCircle) {
+			bool hit = boxCircle(b, a, contact);
+			contact.normal = -contact.normal;
+			return hit;
+		}
+
+		return boxBox(a, b, contact);
+	}
+
+	void gather(EntityPool* pool) {
+		using namespace Components;
+
+		bodies.clear();
+
+		pool->view<const Collider, const Transform, const WorldTransform*, const Kinematics*, const Parent*>().each(
+			[this](Entity entity, const Collider& collider, const Transform& t, const WorldTransform* w, const Kinematics* k, const Parent* p) {
+				glm::vec2 position = w ? w->position : t.position;
+				float angle = w ? w->angle : t.angle;
+				float scale = w ? w->scale : t.scale;
+				bodies.push_back(makeBody(entity, collider, position, angle, scale, k && !p));
+			}
+		);
+	}
+
+	// Bodies come out of the view in the same order until something structural
+	// happens, so last step's order is nearly sorted and insertion sort runs
+	// close to linear. Falls back to a full sort once that stops paying off.
+	void sortBodies() {
+		size_t count = bodies.size();
+		auto less = [this](Uint32 l, Uint32 r) {
+			return bodies[l].min.x < bodies[r].min.x || (bodies[l].min.x == bodies[r].min.x && l < r);
+		};
+
+		if (order.size() != count) {
+			order.resize(count);
+			std::iota(order.begin(), order.end(), 0u);
+			std::sort(order.begin(), order.end(), less);
+			return;
+		}
+
+		size_t budget = count * 8;
+		size_t shifts = 0;
+
+		for (size_t i = 1; i < count; ++i) {
+			Uint32 value = order[i];
+			size_t j = i;
+
+			while (j > 0 && less(value, order[j - 1])) {
+				order[j] = order[j - 1];
+				--j;
+			}
+
+			order[j] = value;
+			shifts += i - j;
+
+			if (shifts > budget) {
+				std::sort(order.begin(), order.end(), less);
+				return;
+			}
+		}
+	}
+
+	void broadphase() {
+		size_t count = bodies.size();
+
+		minX.resize(count);
+		maxX.resize(count);
+		minY.resize(count);
+		maxY.resize(count);
+
+		for (size_t i = 0; i < count; ++i) {
+			const Body& body = bodies[order[i]];
+			minX[i] = body.min.x;
+			maxX[i] = body.max.x;
+			minY[i] = body.min.y;
+			maxY[i] = body.max.y;
+		}
+
+		pairs.clear();
+
+		for (size_t i = 0; i < count; ++i) {
+			for (size_t j = i + 1; j < count && minX[j] <= maxX[i]; ++j) {
+				if (minY[j] > maxY[i] || maxY[j] < minY[i])
+					continue;
+
+				if (canCollide(bodies[order[i]], bodies[order[j]]))
+					pairs.emplace_back(order[i], order[j]);
+			}
+		}
+	}
+
+	void narrowphase() {
+		contacts.clear();
+		contactBodies.clear();
+
+		for (auto [first, second] : pairs) {
+			const Body& a = bodies[first];
+			const Body& b = bodies[second];
+			Contact contact;
+
+			if (!collide(a, b, contact))
+				continue;
+
+			contact.a = a.entity;
+			contact.b = b.entity;
+			contact.isTrigger = a.isTrigger || b.isTrigger;
+			contacts.push_back(contact);
+			contactBodies.emplace_back(first, second);
+		}
+	}
+
+	// Splits each correction between the dynamic bodies of a contact. Fetching
+	// through getComponent leaves untouched Transforms unmarked, so resting
+	// static geometry doesn't show up in Changed<Transform>.
+	void resolve(EntityPool* pool) {
+		for (size_t i = 0; i < contacts.size(); ++i) {
+			const Contact& contact = contacts[i];
+			const Body& a = bodies[contactBodies[i].first];
+			const Body& b = bodies[contactBodies[i].second];
+
+			if (contact.isTrigger)
+				continue;
+
+			float share = (a.isDynamic && b.isDynamic) ? 0.5f : 1.0f;
+			glm::vec2 correction = contact.normal * (contact.depth * share);
+
+			if (a.isDynamic) {
+				pool->getComponent<Components::Transform>(a.entity)->position -= correction;
+				pool->markChanged<Components::Transform>(a.entity);
+			}
+
+			if (b.isDynamic) {
+				pool->getComponent<Components::Transform>(b.entity)->position += correction;
+				pool->markChanged<Components::Transform>(b.entity);
+			}
+		}
+	}
+
+public:
+	const char* getName() const override { return "CollisionSystem"; }
+
+	void fixedUpdate(EntityPool* pool, float) override {
+		gather(pool);
+		sortBodies();
+		broadphase();
+		narrowphase();
+		resolve(pool);
+	}
+
+	std::span<const Contact> getContacts() const { return contacts; }
+};
+
+} // namespace Blackthorn::ECS::Systems
@@ -3,21 +3,26 @@
 #include "ECS/Components/Kinematics.h"
 #include "ECS/Components/Transform.h"
 #include "ECS/ISystem.h"
+#include "ECS/Systems/VerletKernel.h"
 
 namespace Blackthorn::ECS::Systems {
 
-class BLACKTHORN_API KinematicsSystem : public ISystem {
+class BLACKTHORN_API KinematicsSystem : public System<Reads<>, Writes<Components::Kinematics, Components::Transform>> {
 public:
+	const char* getName() const override { return "KinematicsSystem"; }
+
+	void init(EntityPool* pool) override {
+		pool->group<Components::Kinematics, Components::Transform>();
+	}
+
 	void fixedUpdate(EntityPool* pool, float dt) override {
-		auto view = pool->view<Components::Kinematics, Components::Transform>();
+		auto group = pool->group<Components::Kinematics, Components::Transform>();
 		float dt2 = dt * dt;
-		view.each([dt2](Entity, Components::Kinematics& k, Components::Transform& t) {
-			glm::vec2 temp = t.position;
-			t.position = t.position * 2.0f - k.oldPosition + k.acceleration * dt2;
-			k.oldPosition = temp;
-			k.acceleration *= 0;
+		// Owned storage hands out contiguous runs, which the kernel updates in place.
+		group.eachBatchParallel([dt2](const Entity*, size_t count, Components::Kinematics* k, Components::Transform* t) {
+			VerletKernel::integrate(t, k, count, dt2);
 		});
 	}
 };
 
-} // namespace Blackthorn::ECS::Systems
\ No newline at end of file
+} // namespace Blackthorn::ECS::Systems
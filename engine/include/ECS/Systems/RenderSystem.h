@@ -4,39 +4,112 @@
 #include "ECS/Components/Kinematics.h"
 #include "ECS/Components/Sprite.h"
 #include "ECS/Components/Transform.h"
+#include "ECS/Components/WorldTransform.h"
 #include "ECS/ISystem.h"
+#include "ECS/RenderList.h"
 
 namespace Blackthorn::ECS::Systems {
 
-class BLACKTHORN_API RenderSystem : public ISystem {
+class BLACKTHORN_API RenderSystem : public System<
+	Reads<Components::Transform, Components::WorldTransform, Components::Kinematics>,
+	Writes<Components::Sprite>
+> {
 	Graphics::Renderer* renderer;
 
+	// Sprites in draw order; kept sorted across frames so only sprites whose
+	// key changed get re-placed.
+	RenderList renderList;
+	EntityPool* observedPool = nullptr;
+	ObserverID spriteRemoved = INVALID_OBSERVER;
+
+	static RenderList::Key sortKey(const Components::Sprite& s) {
+		return RenderList::Key{ s.layer, s.zOrder, s.texture ? s.texture->getID() : 0u };
+	}
+
+	static SDL_FRect destRect(const Components::Sprite& s, glm::vec2 position, float scale) {
+		SDL_FRect dest{ position.x, position.y, s.src.w * scale, s.src.h * scale };
+
+		if (s.flipX)
+			dest.w *= -1;
+
+		if (s.flipY)
+			dest.y *= -1;
+
+		return dest;
+	}
+
 public:
+	const char* getName() const override { return "RenderSystem"; }
+
 	BLACKTHORN_API RenderSystem(Graphics::Renderer* ren) : renderer(ren) {}
 
+	~RenderSystem() override {
+		if (observedPool)
+			observedPool->removeObserver(spriteRemoved);
+	}
+
+	void init(ECS::EntityPool* pool) override {
+		observedPool = pool;
+		spriteRemoved = pool->onRemove<Components::Sprite>([this](EntityPool&, std::span<const Entity> entities) {
+			for (Entity entity : entities)
+				renderList.remove(entity);
+		});
+	}
+
 	void render(ECS::EntityPool* pool, float alpha) override {
-		auto view = pool->view<Components::Sprite, Components::Transform, Components::Kinematics*>();
-		view.each([alpha, this](Entity, Components::Sprite& s, Components::Transform& t, Components::Kinematics* k){
-			if (!s.texture)
-				return;
+		// Only sprites whose transform or sprite data changed since the last
+		// frame get their cached dest rect rebuilt. Entities in a hierarchy
+		// are placed by their WorldTransform.
+		auto refresh = [](Entity, Components::Sprite& s, const Components::Transform& t, const Components::WorldTransform* w) {
+			s.dest = w ? destRect(s, w->position, w->scale) : destRect(s, t.position, t.scale);
+		};
 
-			glm::vec2 interpolated = k ? glm::mix(k->oldPosition, t.position, alpha)
-				: t.position;
+		using Components::Sprite;
+		using Components::Transform;
+		using Components::WorldTransform;
 
-			s.dest.x = interpolated.x;
-			s.dest.y = interpolated.y;
-			s.dest.w = s.src.w * t.scale;
-			s.dest.h = s.src.h * t.scale;
+		// Sort keys first, before the refresh below marks sprites changed.
+		// The first frame sees every sprite as changed and fills the list.
+		pool->view<const Sprite, Changed<Sprite>>().each([this](Entity entity, const Sprite& s) {
+			renderList.assign(entity, sortKey(s));
+		});
 
-			if (s.flipX)
-				s.dest.w *= -1;
+		pool->view<Sprite, const Transform, const WorldTransform*, Changed<Sprite>>().each(refresh);
+		pool->view<Sprite, const Transform, const WorldTransform*, Changed<Transform>>().each(refresh);
+		pool->view<Sprite, const Transform, const WorldTransform*, Changed<WorldTransform>>().each(refresh);
 
-			if (s.flipY)
-				s.dest.y *= -1;
+		// Submitted back to front by (layer, zOrder, texture), so equal depths
+		// batch by texture. Components are fetched by entity; getComponent
+		// doesn't mark them changed. Each sprite sets its own layer, and the
+		// caller's is put back afterwards for whatever it draws next.
+		Uint8 callerLayer = renderer->getLayer();
 
-			renderer->drawTexture(*s.texture, s.dest, &s.src, t.angle, s.zOrder);
-		});
+		for (Entity entity : renderList.sorted()) {
+			const Sprite* s = pool->getComponent<Sprite>(entity);
+			const Transform* t = pool->getComponent<Transform>(entity);
+
+			if (!s || !t || !s->texture)
+				continue;
+
+			const auto* k = pool->getComponent<Components::Kinematics>(entity);
+			const WorldTransform* w = pool->getComponent<WorldTransform>(entity);
+			float angle = w ? w->angle : t->angle;
+			renderer->setLayer(s->layer);
+
+			if (!k) {
+				renderer->drawTexture(*s->texture, s->dest, &s->src, angle, s->zOrder);
+				continue;
+			}
+
+			// Inside a hierarchy the local interpolation offset is applied
+			// unrotated, which is exact for roots and close for moving children.
+			glm::vec2 interpolated = glm::mix(k->oldPosition, t->position, alpha);
+			SDL_FRect dest = w ? destRect(*s, w->position + (interpolated - t->position), w->scale) : destRect(*s, interpolated, t->scale);
+			renderer->drawTexture(*s->texture, dest, &s->src, angle, s->zOrder);
+		}
+
+		renderer->setLayer(callerLayer);
 	}
 };
 
-} // namespace Blackthorn::ECS::Systems
\ No newline at end of file
+} // namespace Blackthorn::ECS::Systems
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ECS/Components/Bounds.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/WorldTransform.h"
+#include "ECS/ISystem.h"
+#include "ECS/SpatialGrid.h"
+
+namespace Blackthorn::ECS::Systems {
+
+// Keeps a SpatialGrid of every entity with Bounds and a Transform. Only
+// entities whose Transform, WorldTransform or Bounds changed since the last
+// run are re-indexed, and entities losing Bounds or Transform leave the grid
+// through remove observers; it refreshes in both update and fixedUpdate so
+// queries from either phase see current positions. The scheduler can't see
+// grid access, so systems querying it should not share a stage with this
+// one (e.g. declare a write on a component it reads).
+class BLACKTHORN_API SpatialIndexSystem : public System<
+	Reads<Components::Bounds, Components::Transform, Components::WorldTransform>,
+	Writes<>
+> {
+private:
+	SpatialGrid grid;
+	EntityPool* observedPool = nullptr;
+	ObserverID boundsRemoved = INVALID_OBSERVER;
+	ObserverID transformRemoved = INVALID_OBSERVER;
+	ObserverID restored = INVALID_OBSERVER;
+
+	void reindex(Entity entity, const Components::Bounds& bounds, const Components::Transform& local, const Components::WorldTransform* world) {
+		glm::vec2 position = world ? world->position : local.position;
+		float scale = world ? world->scale : local.scale;
+
+		glm::vec2 min = position + bounds.offset * scale;
+		glm::vec2 max = min + bounds.size * scale;
+		grid.insert(entity, glm::min(min, max), glm::max(min, max));
+	}
+
+	void refresh(EntityPool* pool) {
+		auto update = [this](Entity entity, const Components::Bounds& b, const Components::Transform& t, const Components::WorldTransform* w) {
+			reindex(entity, b, t, w);
+		};
+
+		using Components::Bounds;
+		using Components::Transform;
+		using Components::WorldTransform;
+
+		pool->view<const Bounds, const Transform, const WorldTransform*, Changed<Bounds>>().each(update);
+		pool->view<const Bounds, const Transform, const WorldTransform*, Changed<Transform>>().each(update);
+		pool->view<const Bounds, const Transform, const WorldTransform*, Changed<WorldTransform>>().each(update);
+	}
+
+public:
+	explicit SpatialIndexSystem(float cellSize = 128.0f)
+		: grid(cellSize)
+	{}
+
+	~SpatialIndexSystem() override {
+		if (!observedPool)
+			return;
+
+		observedPool->removeObserver(boundsRemoved);
+		observedPool->removeObserver(transformRemoved);
+		observedPool->removeObserver(restored);
+	}
+
+	const char* getName() const override { return "SpatialIndexSystem"; }
+
+	void init(EntityPool* pool) override {
+		observedPool = pool;
+
+		auto unindex = [this](EntityPool&, std::span<const Entity> entities) {
+			for (Entity entity : entities)
+				grid.remove(entity);
+		};
+
+		boundsRemoved = pool->onRemove<Components::Bounds>(unindex);
+		transformRemoved = pool->onRemove<Components::Transform>(unindex);
+
+		// A restore fires no remove events but marks every component changed,
+		// so the next refresh re-indexes whatever the snapshot holds.
+		restored = pool->onRestore([this](EntityPool&) {
+			grid.clear();
+		});
+	}
+
+	void update(EntityPool* pool, float) override { refresh(pool); }
+	void fixedUpdate(EntityPool* pool, float) override { refresh(pool); }
+
+	SpatialGrid& getGrid() { return grid; }
+	const SpatialGrid& getGrid() const { return grid; }
+};
+
+} // namespace Blackthorn::ECS::Systems
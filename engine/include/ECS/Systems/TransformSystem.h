@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "ECS/Components/Children.h"
+#include "ECS/Components/Parent.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Components/WorldTransform.h"
+#include "ECS/ISystem.h"
+
+namespace Blackthorn::ECS::Systems {
+
+// Propagates Transform down Parent/Children links into WorldTransform. Only
+// subtrees whose topmost changed entity had its Transform changed (or just
+// got a WorldTransform) since the last run are recomputed, breadth-first so
+// parents always settle before their children.
+class BLACKTHORN_API TransformSystem : public System<
+	Reads<Components::Transform, Components::Parent, Components::Children>,
+	Writes<Components::WorldTransform>
+> {
+private:
+	std::vector<Entity> dirtyRoots;
+	std::vector<Entity> queue;
+	bool parallel = true;
+
+	static bool isDirty(const EntityPool* pool, Entity entity, Uint32 since) {
+		return pool->getChangedTick<Components::Transform>(entity) > since
+			|| pool->getAddedTick<Components::WorldTransform>(entity) > since;
+	}
+
+	static bool hasDirtyAncestor(const EntityPool* pool, Entity entity, Uint32 since) {
+		for (const auto* parent = pool->getComponent<Components::Parent>(entity); parent;
+			parent = pool->getComponent<Components::Parent>(parent->entity))
+		{
+			if (isDirty(pool, parent->entity, since))
+				return true;
+		}
+
+		return false;
+	}
+
+	static void propagate(EntityPool* pool, Entity root, std::vector<Entity>& pending) {
+		pending.clear();
+		pending.push_back(root);
+
+		for (size_t i = 0; i < pending.size(); ++i) {
+			Entity entity = pending[i];
+			const auto* local = pool->getComponent<Components::Transform>(entity);
+			auto* world = pool->getComponent<Components::WorldTransform>(entity);
+
+			if (!local || !world)
+				continue;
+
+			const auto* parent = pool->getComponent<Components::Parent>(entity);
+			const auto* parentWorld = parent ? pool->getComponent<Components::WorldTransform>(parent->entity) : nullptr;
+
+			*world = parentWorld ? Components::WorldTransform::compose(*parentWorld, *local) : Components::WorldTransform(*local);
+			pool->markChanged<Components::WorldTransform>(entity);
+
+			if (const auto* children = pool->getComponent<Components::Children>(entity))
+				pending.insert(pending.end(), children->entities.begin(), children->entities.end());
+		}
+	}
+
+public:
+	const char* getName() const override { return "TransformSystem"; }
+
+	// Independent dirty subtrees are spread over the job system. Archetype
+	// pools always propagate serially since change ticks are per chunk.
+	void setParallel(bool enabled) { parallel = enabled; }
+	bool isParallel() const { return parallel; }
+
+	void update(EntityPool* pool, float) override {
+		Uint32 since = Detail::lastRunTick;
+		dirtyRoots.clear();
+
+		auto collect = [&](Entity entity) {
+			if (!hasDirtyAncestor(pool, entity, since))
+				dirtyRoots.push_back(entity);
+		};
+
+		pool->view<Changed<Components::Transform>, With<Components::WorldTransform>>().each(collect);
+		pool->view<Added<Components::WorldTransform>>().each(collect);
+
+		std::sort(dirtyRoots.begin(), dirtyRoots.end());
+		dirtyRoots.erase(std::unique(dirtyRoots.begin(), dirtyRoots.end()), dirtyRoots.end());
+
+		JobSystem* jobs = pool->getJobSystem();
+
+		if (!parallel || !jobs || pool->getStorageMode() == StorageMode::Archetype) {
+			for (Entity root : dirtyRoots)
+				propagate(pool, root, queue);
+
+			return;
+		}
+
+		jobs->parallelFor(dirtyRoots.size(), 1, [&](size_t begin, size_t end) {
+			static thread_local std::vector<Entity> pending;
+
+			for (size_t i = begin; i < end; ++i)
+				propagate(pool, dirtyRoots[i], pending);
+		});
+	}
+};
+
+} // namespace Blackthorn::ECS::Systems
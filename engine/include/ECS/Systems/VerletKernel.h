@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Core/Export.h"
+#include "ECS/Components/Kinematics.h"
+#include "ECS/Components/Transform.h"
+
+namespace Blackthorn::ECS::Systems {
+
+// Integrates Verlet bodies in place on the component arrays. Transform and
+// Kinematics are both four packed floats, so a body fills one SSE register
+// per component (two bodies per AVX register) and nothing is staged in or
+// out. The kernel updates positions, previous positions and clears
+// accelerations; angle and scale pass through untouched.
+class BLACKTHORN_API VerletKernel {
+public:
+	enum class Level {
+		Scalar,
+		SSE,
+		AVX
+	};
+
+	// Every level computes position * 2 - oldPosition + acceleration * dt2
+	// without fused multiply-add, so results are bit-identical across them.
+	static void integrate(Components::Transform* transforms, Components::Kinematics* kinematics, size_t count, float dt2);
+
+	// Best level the running CPU supports; picked once on first use.
+	static Level detectLevel();
+
+	// Forces a kernel, clamped to what the CPU supports.
+	static void setLevel(Level level);
+	static Level getLevel();
+};
+
+} // namespace Blackthorn::ECS::Systems
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "ECS/Components/Tag.h"
+#include "ECS/EntityPool.h"
+
+namespace Blackthorn::ECS {
+
+// Symbol -> entities lookup over Components::Tag, kept current by immediate
+// observers on the pool and rebuilt after a snapshot restore. Tags must be
+// changed through addComponent (a replace) rather than written in place,
+// since that fires no observer.
+class TagIndex {
+private:
+	EntityPool& pool;
+	std::unordered_map<Utils::Symbol, std::vector<Entity>> index;
+	std::vector<Utils::Symbol> symbols;
+	ObserverID addObserver = INVALID_OBSERVER;
+	ObserverID removeObserver = INVALID_OBSERVER;
+	ObserverID replaceObserver = INVALID_OBSERVER;
+	ObserverID restoreObserver = INVALID_OBSERVER;
+
+	void link(Entity entity, Utils::Symbol symbol) {
+		Uint32 slot = Detail::entityIndex(entity);
+
+		if (slot >= symbols.size())
+			symbols.resize(slot + 1, Utils::INVALID_SYMBOL);
+
+		symbols[slot] = symbol;
+		index[symbol].push_back(entity);
+	}
+
+	void unlink(Entity entity) {
+		Uint32 slot = Detail::entityIndex(entity);
+
+		if (slot >= symbols.size() || symbols[slot] == Utils::INVALID_SYMBOL)
+			return;
+
+		auto it = index.find(symbols[slot]);
+		symbols[slot] = Utils::INVALID_SYMBOL;
+
+		if (it == index.end())
+			return;
+
+		auto& list = it->second;
+		auto pos = std::find(list.begin(), list.end(), entity);
+
+		if (pos != list.end()) {
+			*pos = list.back();
+			list.pop_back();
+		}
+
+		if (list.empty())
+			index.erase(it);
+	}
+
+	void relink(Entity entity) {
+		unlink(entity);
+
+		if (const auto* tag = pool.getComponent<Components::Tag>(entity))
+			link(entity, tag->symbol);
+	}
+
+public:
+	explicit TagIndex(EntityPool& entityPool)
+		: pool(entityPool)
+	{
+		addObserver = pool.onAdd<Components::Tag>([this](EntityPool&, std::span<const Entity> entities) {
+			for (Entity entity : entities)
+				relink(entity);
+		});
+
+		replaceObserver = pool.onReplace<Components::Tag>([this](EntityPool&, std::span<const Entity> entities) {
+			for (Entity entity : entities)
+				relink(entity);
+		});
+
+		removeObserver = pool.onRemove<Components::Tag>([this](EntityPool&, std::span<const Entity> entities) {
+			for (Entity entity : entities)
+				unlink(entity);
+		});
+
+		restoreObserver = pool.onRestore([this](EntityPool&) {
+			rebuild();
+		});
+
+		rebuild();
+	}
+
+	~TagIndex() {
+		pool.removeObserver(addObserver);
+		pool.removeObserver(replaceObserver);
+		pool.removeObserver(removeObserver);
+		pool.removeObserver(restoreObserver);
+	}
+
+	TagIndex(const TagIndex&) = delete;
+	TagIndex& operator=(const TagIndex&) = delete;
+
+	void rebuild() {
+		index.clear();
+		symbols.clear();
+
+		pool.view<const Components::Tag>().each([this](Entity entity, const Components::Tag& tag) {
+			link(entity, tag.symbol);
+		});
+	}
+
+	std::span<const Entity> findAll(Utils::Symbol symbol) const {
+		auto it = index.find(symbol);
+		return it != index.end() ? std::span<const Entity>(it->second) : std::span<const Entity>();
+	}
+
+	// Doesn't intern `name`: unknown names just find nothing.
+	std::span<const Entity> findAll(std::string_view name) const {
+		Utils::Symbol symbol = Utils::StringInterner::global().find(name);
+		return symbol != Utils::INVALID_SYMBOL ? findAll(symbol) : std::span<const Entity>();
+	}
+
+	Entity find(std::string_view name) const {
+		auto entities = findAll(name);
+		return entities.empty() ? INVALID_ENTITY : entities.front();
+	}
+
+	size_t size() const { return index.size(); }
+};
+
+} // namespace Blackthorn::ECS
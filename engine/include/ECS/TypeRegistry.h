@@ -0,0 +1,88 @@
+#pragma once
+
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <SDL3/SDL.h>
+
+#include "Core/Export.h"
+
+namespace Blackthorn::ECS {
+
+using TypeHash = Uint64;
+
+namespace Detail {
+
+	constexpr TypeHash fnv1a(std::string_view text) {
+		TypeHash hash = 0xCBF29CE484222325ULL;
+
+		for (char c : text)
+			hash = (hash ^ static_cast<Uint8>(c)) * 0x100000001B3ULL;
+
+		return hash;
+	}
+
+	// Fully qualified name of T, cut out of the compiler's signature string.
+	// Same spelling in every module built by the same compiler.
+	template <typename T>
+	constexpr std::string_view typeName() {
+#if defined(_MSC_VER) && !defined(__clang__)
+		std::string_view signature = __FUNCSIG__;
+		size_t begin = signature.find("typeName<") + 9;
+		size_t end = signature.rfind(">(void)");
+#else
+		std::string_view signature = __PRETTY_FUNCTION__;
+		size_t begin = signature.find("T = ") + 4;
+		size_t end = signature.find(';', begin);
+
+		if (end == std::string_view::npos)
+			end = signature.rfind(']');
+#endif
+		return signature.substr(begin, end - begin);
+	}
+
+	template <typename T>
+	constexpr TypeHash typeHash = fnv1a(typeName<T>());
+
+} // namespace Detail
+
+// Hands out dense component ids keyed by type hash. It lives in the engine
+// library, so the game, tools and hot-reloaded modules all get the same id
+// for the same type no matter which of them registers it first.
+class BLACKTHORN_API TypeRegistry {
+private:
+	struct Entry {
+		TypeHash hash = 0;
+		std::string name;
+	};
+
+	// A deque, so entries never move and views returned by name() stay
+	// valid as more types register.
+	std::unordered_map<TypeHash, size_t> lookup;
+	std::deque<Entry> types;
+	mutable std::shared_mutex mutex;
+
+public:
+	static constexpr size_t NO_TYPE = SIZE_MAX;
+
+	TypeRegistry() = default;
+
+	TypeRegistry(const TypeRegistry&) = delete;
+	TypeRegistry& operator=(const TypeRegistry&) = delete;
+
+	// Id for `hash`, assigning the next one on first sight. Throws when two
+	// names share a hash or the ids run past MAX_COMPONENTS.
+	size_t assure(TypeHash hash, std::string_view name);
+
+	size_t find(TypeHash hash) const;
+	std::string_view name(size_t id) const;
+	TypeHash hash(size_t id) const;
+	size_t size() const;
+
+	static TypeRegistry& global();
+};
+
+} // namespace Blackthorn::ECS
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+
 #include "Core/Export.h"
 #include "ECS/EntityPool.h"
 #include "ECS/SystemManager.h"
@@ -8,8 +10,8 @@ namespace Blackthorn::ECS {
 
 class BLACKTHORN_API World {
 public:
-	World(size_t maxEntities = Detail::MAX_ENTITIES)
-		: pool(maxEntities)
+	World(size_t initialCapacity = Detail::INITIAL_ENTITY_CAPACITY, StorageMode mode = StorageMode::SparseSet)
+		: pool(initialCapacity, mode)
 		, systemManager(pool)
 	{}
 
@@ -25,10 +27,24 @@ public:
 
 	World& operator=(World&& other) = delete;
 
+	// Copies entities and components in bulk. Systems and observers stay
+	// with this world; add them to the clone before stepping it.
+	std::unique_ptr<World> clone() const {
+		return std::unique_ptr<World>(new World(pool.clone()));
+	}
+
 	Entity createEntity() {
 		return pool.create();
 	}
 
+	std::vector<Entity> createEntities(size_t count) {
+		return pool.createMany(count);
+	}
+
+	std::vector<Entity> instantiate(const Prefab& prefab, size_t count) {
+		return pool.instantiate(prefab, count);
+	}
+
 	void destroyEntity(Entity entity) {
 		pool.destroy(entity);
 	}
@@ -41,13 +57,43 @@ public:
 		return pool.aliveCount();
 	}
 
+	StorageMode getStorageMode() const {
+		return pool.getStorageMode();
+	}
+
+	void setJobSystem(JobSystem* jobs) {
+		pool.setJobSystem(jobs);
+	}
+
+	JobSystem* getJobSystem() const {
+		return pool.getJobSystem();
+	}
+
 	void clear() {
 		pool.clear();
 	}
 
+	template <typename Component>
+	void registerComponent() {
+		pool.registerComponent<Component>();
+	}
+
+	void saveSnapshot(Snapshot& snapshot) const {
+		pool.saveSnapshot(snapshot);
+	}
+
+	void restoreSnapshot(const Snapshot& snapshot) {
+		pool.restoreSnapshot(snapshot);
+	}
+
 	template <typename Component, typename... Args>
 	Component& addComponent(Entity entity, Args&&... args) {
-		pool.addComponent<Component>(entity, std::forward<Args>(args)...);
+		return pool.addComponent<Component>(entity, std::forward<Args>(args)...);
+	}
+
+	template <typename... Components>
+	void addComponents(std::span<const Entity> entities, const Components&... values) {
+		pool.addComponents<Components...>(entities, values...);
 	}
 
 	template <typename Component>
@@ -70,8 +116,32 @@ public:
 		return pool.getComponent<Component>(entity);
 	}
 
+	template <typename Component>
+	void markChanged(Entity entity) {
+		pool.markChanged<Component>(entity);
+	}
+
+	template <typename Component>
+	ObserverID onAdd(ObserverCallback callback, ObserverDelivery delivery = ObserverDelivery::Immediate) {
+		return pool.onAdd<Component>(std::move(callback), delivery);
+	}
+
+	template <typename Component>
+	ObserverID onRemove(ObserverCallback callback, ObserverDelivery delivery = ObserverDelivery::Immediate) {
+		return pool.onRemove<Component>(std::move(callback), delivery);
+	}
+
+	template <typename Component>
+	ObserverID onReplace(ObserverCallback callback, ObserverDelivery delivery = ObserverDelivery::Immediate) {
+		return pool.onReplace<Component>(std::move(callback), delivery);
+	}
+
+	void removeObserver(ObserverID id) {
+		pool.removeObserver(id);
+	}
+
 	template <typename... Components>
-	Detail::View<Components...> view() {
+	Detail::ViewType<Components...> view() {
 		return pool.view<Components...>();
 	}
 
@@ -106,6 +176,11 @@ public:
 private:
 	EntityPool pool;
 	Systems::SystemManager systemManager;
+
+	explicit World(EntityPool&& clonedPool)
+		: pool(std::move(clonedPool))
+		, systemManager(pool)
+	{}
 };
 
 } // namespace Blackthorn::ECS
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include <glm/glm.hpp>
 #include <SDL3/SDL.h>
@@ -10,6 +11,7 @@
 #include "Graphics/EBO.h"
 #include "Graphics/Shader.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureArray.h"
 #include <Graphics/UBO.h>
 #include "Graphics/VAO.h"
 #include "Graphics/VBO.h"
@@ -28,6 +30,42 @@ struct Vertex2D {
 	float texIndex;
 };
 
+/**
+ * @brief Per-sprite record for the instanced path.
+ *
+ * The vertex shader expands each record over a static unit quad and does
+ * the rotation, so a sprite costs 40 bytes instead of four Vertex2Ds.
+ * UVs are stored as normalized 16-bit values and must lie in [0, 1].
+ */
+struct SpriteInstance {
+	/// Quad center in world space
+	glm::vec2 center;
+	/// Quad width and height; negative values mirror
+	glm::vec2 size;
+	/// Rotation in radians around the center
+	float rotation;
+	/// Z-depth value
+	float z;
+	/// u0, v1, u1, v0: the UVs of the first and third corner
+	std::array<Uint16, 4> uvRect;
+	/// RGBA8 color
+	std::array<Uint8, 4> color;
+	/// Texture slot, or texture array layer
+	float texIndex;
+};
+
+static_assert(sizeof(SpriteInstance) == 40);
+
+/**
+ * @brief How queued draws within a layer are ordered at endScene().
+ */
+enum class SortMode : Uint8 {
+	/// By depth, then shader and texture, so equal depths batch together
+	Batched,
+	/// By depth, then submission order; for translucent layers
+	Stable
+};
+
 /**
  * @brief Batched 2D renderer built on OpenGL.
  *
@@ -40,6 +78,18 @@ struct Vertex2D {
  * - draw calls
  * - endScene()
  *
+ * Draw calls are queued with a 64-bit sort key and only turned into
+ * batches at endScene(), ordered by layer, depth, shader and texture, so
+ * interleaved sprites from many textures don't force a flush whenever a
+ * seventeenth texture shows up.
+ *
+ * With a TextureArray attached, draws whose texture is packed into it
+ * sample the array layer named in the vertex instead of a texture slot,
+ * so any number of packed textures go out in one draw.
+ *
+ * With instancing enabled, each sprite is sent as one SpriteInstance and
+ * expanded on the GPU instead of as four CPU-transformed vertices.
+ *
  * Copying is disallowed; the renderer owns GPU resources and enforces
  * a single point of control.
  *
@@ -68,9 +118,34 @@ private:
 	/// Vertex buffer for batched quad data
 	std::unique_ptr<VBO> QuadVBO;
 
+	/// Vertex array object for the instanced layout
+	std::unique_ptr<VAO> InstanceVAO;
+
+	/// Static unit quad corners shared by every instance
+	std::unique_ptr<VBO> CornerVBO;
+
+	/// Vertex buffer for batched instance data
+	std::unique_ptr<VBO> InstanceVBO;
+
 	/// Shader used for 2D rendering
 	std::unique_ptr<Shader> shader;
 
+	/// Shader used for batches sampling the texture array
+	std::unique_ptr<Shader> arrayShader;
+
+	/// Texture array sampled by packed textures, if any
+	const TextureArray* textureArray = nullptr;
+
+	/// Texture array the current batch samples, or nullptr for texture slots
+	const TextureArray* batchArray = nullptr;
+
+	/// Instanced counterparts of shader and arrayShader
+	std::unique_ptr<Shader> instancedShader;
+	std::unique_ptr<Shader> instancedArrayShader;
+
+	/// Whether sprites are sent as instances
+	bool instancingEnabled = false;
+
 	/**
 	 * @brief Global uniform data shared across draw calls.
 	 */
@@ -97,6 +172,12 @@ private:
 	/// Pointer to the current position in the batch buffer
 	Vertex2D* quadBufferPtr = nullptr;
 
+	/// CPU-side instance buffer for batching
+	std::unique_ptr<SpriteInstance[]> instanceBuffer;
+
+	/// Pointer to the current position in the instance buffer
+	SpriteInstance* instanceBufferPtr = nullptr;
+
 	/// Number of indices currently queued in the batch
 	Uint32 quadIndexCount = 0;
 
@@ -106,6 +187,44 @@ private:
 	/// Next available texture slot index
 	Uint32 textureSlotIndex = 1;
 
+	/**
+	 * @brief A queued draw call, replayed into the batch at endScene().
+	 */
+	struct DrawCommand {
+		SDL_FRect rect;
+		SDL_FRect src;
+		SDL_FColor color;
+		const Texture* texture;
+		float z;
+		float rotation;
+		const TextureArray* array;
+		int arrayLayer;
+		bool hasSrc;
+	};
+
+	/**
+	 * @brief Sort key and the index of the command it belongs to.
+	 */
+	struct SortEntry {
+		Uint64 key;
+		Uint32 index;
+	};
+
+	/// Draw calls queued since beginScene()
+	std::vector<DrawCommand> commands;
+
+	/// Sort keys of the queued commands
+	std::vector<SortEntry> sortEntries;
+
+	/// Scratch buffer for the radix sort
+	std::vector<SortEntry> sortScratch;
+
+	/// Layer assigned to subsequent draw calls
+	Uint8 currentLayer = 0;
+
+	/// Sort mode of each layer
+	std::array<SortMode, 256> layerSortModes;
+
 	/// Projection matrix
 	glm::mat4 projectionMatrix;
 
@@ -113,7 +232,7 @@ private:
 	glm::mat4 viewMatrix;
 
 	/**
-	 * @brief Initializes the renderer shader.
+	 * @brief Initializes the renderer shaders.
 	 */
 	void initShader();
 
@@ -122,6 +241,11 @@ private:
 	 */
 	void initQuadBuffers();
 
+	/**
+	 * @brief Initializes the instanced VAO and its corner and instance VBOs.
+	 */
+	void initInstanceBuffers();
+
 	/**
 	 * @brief Creates the default white texture.
 	 */
@@ -142,6 +266,27 @@ private:
 	 */
 	void flush();
 
+	/**
+	 * @brief Builds the sort key of a draw call.
+	 *
+	 * Layout, most significant first: layer (8 bits), depth (32 bits),
+	 * shader (8 bits), texture (16 bits). Draws sampling a texture array
+	 * use shader 1 and the array's handle as the texture. Stable layers
+	 * leave shader and texture zero so equal depths keep their submission
+	 * order.
+	 */
+	Uint64 sortKey(float z, const Texture* texture, const TextureArray* array) const;
+
+	/**
+	 * @brief Radix-sorts the queued commands by key, preserving submission order for equal keys.
+	 */
+	void sortCommands();
+
+	/**
+	 * @brief Writes a queued draw call into the current batch.
+	 */
+	void emit(const DrawCommand& command);
+
 	/**
 	 * @brief Checks whether a rectangle is visible within the view bounds.
 	 * @param rect Rectangle to test.
@@ -154,13 +299,23 @@ private:
 	 */
 	static inline constexpr glm::vec4 toGLMColor(const SDL_FColor& color);
 
+	/**
+	 * @brief Packs an SDL color into RGBA8.
+	 */
+	static inline std::array<Uint8, 4> toRGBA8(const SDL_FColor& color);
+
+	/**
+	 * @brief Packs a texture coordinate into a normalized 16-bit value.
+	 */
+	static inline Uint16 toUNorm16(float value);
+
 	/**
 	 * @brief Converts two floats to a glm::vec2.
 	 */
 	static inline constexpr glm::vec2 toGLMVec2(float x, float y);
 
 	/**
-	 * @brief Internal quad draw implementation.
+	 * @brief Queues a quad draw call.
 	 */
 	void draw(const SDL_FRect& rect, float z, float rotation, const SDL_FColor& color, const Texture* texture, const SDL_FRect* srcRect);
 public:
@@ -188,10 +343,61 @@ public:
 	void beginScene();
 
 	/**
-	 * @brief Ends the current rendering scene and flushes pending draws.
+	 * @brief Ends the current rendering scene.
+	 *
+	 * Sorts the queued draw calls, batches them in order and flushes.
 	 */
 	void endScene();
 
+	/**
+	 * @brief Sets the layer of subsequent draw calls.
+	 *
+	 * Lower layers are drawn first. The layer stays set across scenes.
+	 */
+	void setLayer(Uint8 layer) { currentLayer = layer; }
+
+	/**
+	 * @brief Returns the layer of subsequent draw calls.
+	 */
+	Uint8 getLayer() const { return currentLayer; }
+
+	/**
+	 * @brief Sets how draw calls within a layer are ordered.
+	 */
+	void setLayerSortMode(Uint8 layer, SortMode mode) { layerSortModes[layer] = mode; }
+
+	/**
+	 * @brief Returns how draw calls within a layer are ordered.
+	 */
+	SortMode getLayerSortMode(Uint8 layer) const { return layerSortModes[layer]; }
+
+	/**
+	 * @brief Attaches a texture array, or detaches it with nullptr.
+	 *
+	 * Textures packed into the array, and untextured quads, are drawn
+	 * from it; other textures still use texture slots. Each draw keeps
+	 * the array attached when it was queued, so the array can be changed
+	 * mid-scene. It must outlive the endScene() that draws from it.
+	 */
+	void setTextureArray(const TextureArray* array) { textureArray = array; }
+
+	/**
+	 * @brief Returns the attached texture array, if any.
+	 */
+	const TextureArray* getTextureArray() const { return textureArray; }
+
+	/**
+	 * @brief Enables or disables the instanced sprite path.
+	 *
+	 * Takes effect at the next endScene().
+	 */
+	void setInstancingEnabled(bool enabled) { instancingEnabled = enabled; }
+
+	/**
+	 * @brief Checks whether the instanced sprite path is enabled.
+	 */
+	bool isInstancingEnabled() const { return instancingEnabled; }
+
 	/**
 	 * @brief Sets an orthographic projection based on viewport size.
 	 * @param width Viewport width in pixels.
@@ -91,6 +91,9 @@ private:
 	 */
 	static GLenum toGLWrap(TextureWrap wrap);
 
+	/// Shares the filter and wrap conversions
+	friend class TextureArray;
+
 public:
 	/**
 	 * @brief Constructs an empty texture.
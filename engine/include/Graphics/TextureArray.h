@@ -0,0 +1,170 @@
+#pragma once
+
+#include <unordered_map>
+
+#include <glad/glad.h>
+#include <SDL3/SDL.h>
+
+#include "Core/Export.h"
+#include "Graphics/Texture.h"
+
+namespace Blackthorn::Graphics {
+
+/**
+ * @brief RAII wrapper for an OpenGL 2D array texture of RGBA8 layers.
+ *
+ * Same-sized textures are copied into layers so the renderer can draw
+ * sprites from all of them with a single bound texture, selecting the
+ * layer per vertex. Layer 0 is reserved and filled with opaque white so
+ * untextured quads can share the same draw.
+ *
+ * Packed textures are looked up by their OpenGL handle. The copy is
+ * independent: later changes to the source texture are not reflected.
+ *
+ * @note Requires a valid OpenGL context to be current on the calling thread.
+ */
+class BLACKTHORN_API TextureArray {
+private:
+	/// OpenGL texture object handle (0 if uninitialized)
+	GLuint id = 0;
+
+	/// Layer width in pixels
+	int width = 0;
+
+	/// Layer height in pixels
+	int height = 0;
+
+	/// Number of layers allocated
+	int capacity = 0;
+
+	/// Number of layers in use, including the white layer
+	int layerCount = 0;
+
+	/// Texture sampling and wrapping parameters
+	TextureParams params;
+
+	/// Layer of each packed texture, keyed by its OpenGL handle
+	std::unordered_map<GLuint, int> layers;
+
+	/**
+	 * @brief Applies texture parameters to the currently bound array.
+	 */
+	void applyParams();
+
+public:
+	/**
+	 * @brief Constructs an empty texture array.
+	 */
+	TextureArray() = default;
+
+	/**
+	 * @brief Creates a texture array with allocated storage.
+	 * @param width Layer width in pixels.
+	 * @param height Layer height in pixels.
+	 * @param capacity Number of layers, including the white layer.
+	 * @param parameters Texture sampling and wrapping parameters.
+	 */
+	TextureArray(int width, int height, int capacity, const TextureParams& parameters = TextureParams());
+
+	/**
+	 * @brief Destroys the texture array and releases the OpenGL resource.
+	 */
+	~TextureArray();
+
+	/// Copy construction is disabled (unique ownership)
+	TextureArray(const TextureArray&) = delete;
+
+	/// Copy assignment is disabled (unique ownership)
+	TextureArray& operator=(const TextureArray&) = delete;
+
+	/**
+	 * @brief Move-constructs a texture array, transferring ownership.
+	 * @param other Texture array to move from.
+	 */
+	TextureArray(TextureArray&& other) noexcept;
+
+	/**
+	 * @brief Move-assigns a texture array, transferring ownership.
+	 * @param other Texture array to move from.
+	 * @return Reference to this object.
+	 */
+	TextureArray& operator=(TextureArray&& other) noexcept;
+
+	/**
+	 * @brief Allocates storage and fills layer 0 with white.
+	 * @param width Layer width in pixels.
+	 * @param height Layer height in pixels.
+	 * @param capacity Number of layers, including the white layer.
+	 * @param parameters Texture sampling and wrapping parameters.
+	 * @return True on success, false otherwise.
+	 */
+	bool create(int width, int height, int capacity, const TextureParams& parameters = TextureParams());
+
+	/**
+	 * @brief Destroys the texture array and releases its OpenGL resource.
+	 */
+	void destroy();
+
+	/**
+	 * @brief Uploads RGBA8 pixels into the next free layer.
+	 * @param pixels Pointer to width * height RGBA8 pixels.
+	 * @return The layer index, or -1 if the array is full or invalid.
+	 */
+	int addLayer(const void* pixels);
+
+	/**
+	 * @brief Copies a texture into the next free layer.
+	 * @param texture Texture with the same size as the array's layers.
+	 * @return The layer index, or -1 if the sizes differ or the array is full.
+	 *         Adding a texture twice returns its existing layer.
+	 */
+	int add(const Texture& texture);
+
+	/**
+	 * @brief Returns the layer holding a texture, or -1 if it isn't packed.
+	 */
+	int findLayer(const Texture& texture) const;
+
+	/**
+	 * @brief Binds the texture array to a texture unit.
+	 * @param slot Texture unit index.
+	 */
+	void bind(GLuint slot = 0) const;
+
+	/**
+	 * @brief Checks whether the texture array has been created.
+	 */
+	bool isValid() const noexcept { return id != 0; }
+
+	/**
+	 * @brief Returns the OpenGL texture handle.
+	 */
+	GLuint getID() const noexcept { return id; }
+
+	/**
+	 * @brief Returns the layer width in pixels.
+	 */
+	int getWidth() const noexcept { return width; }
+
+	/**
+	 * @brief Returns the layer height in pixels.
+	 */
+	int getHeight() const noexcept { return height; }
+
+	/**
+	 * @brief Returns the number of allocated layers.
+	 */
+	int getCapacity() const noexcept { return capacity; }
+
+	/**
+	 * @brief Returns the number of layers in use, including the white layer.
+	 */
+	int getLayerCount() const noexcept { return layerCount; }
+
+	/**
+	 * @brief Returns the texture parameters.
+	 */
+	const TextureParams& getParams() const noexcept { return params; }
+};
+
+} // namespace Blackthorn::Graphics
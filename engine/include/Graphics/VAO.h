@@ -143,6 +143,15 @@ public:
 	 */
 	void disableAttrib(GLuint index);
 
+	/**
+	 * @brief Sets how often an attribute advances during instanced draws.
+	 * @param index Attribute index/location.
+	 * @param divisor 0 to advance per vertex, N to advance every N instances.
+	 * 
+	 * @pre This VAO must be bound.
+	 */
+	void setAttribDivisor(GLuint index, GLuint divisor);
+
 	/**
 	 * @brief Configures multiple vertex attributes in sequence.
 	 * @param attributes List of vertex attribute descriptions.
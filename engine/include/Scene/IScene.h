@@ -25,6 +25,18 @@ public:
 	virtual bool blocksUpdate() const { return true; }
 	virtual bool blocksRender() const { return true; }
 
+	/**
+	 * @brief Lets SceneManager step this scene on the job pool alongside
+	 * other parallel scenes. Only for scenes that touch nothing outside
+	 * their own world while updating.
+	 */
+	virtual bool updatesInParallel() const { return false; }
+
+	/**
+	 * @brief Component storage backend used for this scene's world.
+	 */
+	virtual ECS::StorageMode getStorageMode() const { return ECS::StorageMode::SparseSet; }
+
 	virtual void fixedUpdate(float dt) {
 		if (world)
 			world->fixedUpdate(dt);
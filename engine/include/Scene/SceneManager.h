@@ -26,6 +26,9 @@ private:
 	float transitionDuration = 0.0f;
 	float transitionTime = 0.0f;
 
+	JobSystem* jobSystem = nullptr;
+	std::vector<IScene*> activeScenes;
+
 	void updateTransition(float dt) {
 		transitionTime += dt;
 
@@ -41,6 +44,47 @@ private:
 		}
 	}
 
+	// Steps every scene from the top down to the first one that blocks
+	// updates. Scenes that update in parallel go to the job pool while the
+	// rest run here, in stack order.
+	template <typename Function>
+	void stepScenes(Function&& step) {
+		activeScenes.clear();
+
+		for (auto it = scenes.rbegin(); it != scenes.rend(); ++it) {
+			activeScenes.push_back(it->get());
+
+			if ((*it)->blocksUpdate())
+				break;
+		}
+
+		if (!jobSystem || jobSystem->getWorkerCount() == 0) {
+			for (IScene* scene : activeScenes)
+				step(*scene);
+
+			return;
+		}
+
+		JobCounter counter;
+
+		for (IScene* scene : activeScenes) {
+			if (scene->updatesInParallel())
+				jobSystem->submit(counter, [scene, &step]() { step(*scene); });
+		}
+
+		try {
+			for (IScene* scene : activeScenes) {
+				if (!scene->updatesInParallel())
+					step(*scene);
+			}
+		} catch (...) {
+			jobSystem->wait(counter);
+			throw;
+		}
+
+		jobSystem->wait(counter);
+	}
+
 public:
 	SceneManager() = default;
 	~SceneManager() = default;
@@ -48,6 +92,17 @@ public:
 	SceneManager(const SceneManager&) = delete;
 	SceneManager& operator=(const SceneManager&) = delete;
 
+	void setJobSystem(JobSystem* jobs) {
+		jobSystem = jobs;
+
+		for (auto& scene : scenes) {
+			if (scene->world)
+				scene->world->setJobSystem(jobs);
+		}
+	}
+
+	JobSystem* getJobSystem() const { return jobSystem; }
+
 	void pushScene(std::unique_ptr<IScene> scene) {
 		if (!scene)
 			return;
@@ -56,7 +111,8 @@ public:
 			scenes.back()->onPause();
 
 		scene->sceneManager = this;
-		scene->world = std::make_unique<ECS::World>();
+		scene->world = std::make_unique<ECS::World>(ECS::Detail::INITIAL_ENTITY_CAPACITY, scene->getStorageMode());
+		scene->world->setJobSystem(jobSystem);
 		scene->onEnter();
 
 		scenes.push_back(std::move(scene));
@@ -80,7 +136,8 @@ public:
 		clear();
 
 		scene->sceneManager = this;
-		scene->world = std::make_unique<ECS::World>();
+		scene->world = std::make_unique<ECS::World>(ECS::Detail::INITIAL_ENTITY_CAPACITY, scene->getStorageMode());
+		scene->world->setJobSystem(jobSystem);
 		scene->onEnter();
 
 		scenes.push_back(std::move(scene));
@@ -108,12 +165,7 @@ public:
 			return;
 		}
 
-		for (auto it = scenes.rbegin(); it != scenes.rend(); ++it) {
-			(*it)->fixedUpdate(dt);
-
-			if ((*it)->blocksUpdate())
-				break;
-		}
+		stepScenes([dt](IScene& scene) { scene.fixedUpdate(dt); });
 	}
 
 	void update(float dt) {
@@ -122,12 +174,7 @@ public:
 			return;
 		}
 
-		for (auto it = scenes.rbegin(); it != scenes.rend(); ++it) {
-			(*it)->update(dt);
-
-			if ((*it)->blocksUpdate())
-				break;
-		}
+		stepScenes([dt](IScene& scene) { scene.update(dt); });
 	}
 
 	void render(float alpha) {
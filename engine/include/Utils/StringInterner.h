@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Core/Export.h"
+
+namespace Utils {
+
+using Symbol = std::uint32_t;
+
+constexpr Symbol EMPTY_SYMBOL = 0;
+constexpr Symbol INVALID_SYMBOL = UINT32_MAX;
+
+// Maps strings to dense 32-bit symbols. Strings are never released, so a
+// symbol and the view returned by resolve() stay valid for the interner's
+// lifetime. Safe to use from several threads.
+class BLACKTHORN_API StringInterner {
+private:
+	std::deque<std::string> strings;
+	std::unordered_map<std::string_view, Symbol> lookup;
+	mutable std::shared_mutex mutex;
+
+public:
+	StringInterner();
+
+	StringInterner(const StringInterner&) = delete;
+	StringInterner& operator=(const StringInterner&) = delete;
+
+	Symbol intern(std::string_view text);
+
+	// INVALID_SYMBOL if `text` was never interned.
+	Symbol find(std::string_view text) const;
+
+	std::string_view resolve(Symbol symbol) const;
+	size_t size() const;
+
+	// Process-wide instance, shared by every module linking the engine.
+	static StringInterner& global();
+};
+
+} // namespace Utils
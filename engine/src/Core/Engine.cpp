@@ -1,5 +1,7 @@
 #include "Core/Engine.h"
 
+#include <algorithm>
+
 #include <glad/glad.h>
 #include <SDL3_ttf/SDL_ttf.h>
 
@@ -136,6 +138,12 @@ bool Engine::init(const EngineConfig& cfg) {
 	}
 
 	initAssetLoaders();
+
+	jobSystem.init(static_cast<Uint32>(std::max(cfg.jobs.workerCount, 0)));
+	jobSystem.setGrainSize(cfg.jobs.grainSize);
+	jobSystem.setDeterministic(cfg.jobs.deterministic);
+	sceneManager.setJobSystem(&jobSystem);
+
 	initialized = true;
 
 	#ifdef BLACKTHORN_DEBUG
@@ -167,6 +175,7 @@ void Engine::shutdown() {
 	if (!initialized)
 		return;
 
+	jobSystem.shutdown();
 	assetManager.clear();
 
 	if (glContext) {
@@ -0,0 +1,218 @@
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+
+namespace Blackthorn {
+
+static thread_local Uint32 threadIndex = 0;
+
+JobSystem::~JobSystem() {
+	shutdown();
+}
+
+void JobSystem::init(Uint32 workerCount) {
+	shutdown();
+
+	if (workerCount == 0) {
+		Uint32 hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+	}
+
+	stopping = false;
+	threadIndex = 0;
+
+	queues.clear();
+	for (Uint32 i = 0; i <= workerCount; ++i)
+		queues.push_back(std::make_unique<WorkQueue>());
+
+	workers.reserve(workerCount);
+	for (Uint32 i = 1; i <= workerCount; ++i)
+		workers.emplace_back(&JobSystem::workerLoop, this, i);
+
+	#ifdef BLACKTHORN_DEBUG
+		SDL_Log("JobSystem initialized (%u workers)", workerCount);
+	#endif
+}
+
+void JobSystem::shutdown() {
+	if (workers.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+
+	wakeCondition.notify_all();
+
+	for (auto& worker : workers)
+		worker.join();
+
+	workers.clear();
+	queues.clear();
+	queuedTasks = 0;
+}
+
+Uint32 JobSystem::currentThreadIndex() {
+	return threadIndex;
+}
+
+void JobSystem::submit(JobCounter& counter, Job job) {
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+	if (workers.empty()) {
+		Task task{std::move(job), &counter};
+		execute(task);
+		return;
+	}
+
+	Uint32 index = std::min<Uint32>(threadIndex, static_cast<Uint32>(queues.size() - 1));
+
+	{
+		std::lock_guard<std::mutex> lock(queues[index]->mutex);
+		queues[index]->tasks.push_back(Task{std::move(job), &counter});
+	}
+
+	queuedTasks.fetch_add(1, std::memory_order_release);
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+
+	wakeCondition.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter) {
+	Uint32 index = std::min<Uint32>(threadIndex, static_cast<Uint32>(queues.empty() ? 0 : queues.size() - 1));
+
+	while (counter.pending.load(std::memory_order_acquire) > 0) {
+		Task task;
+
+		if (popTask(index, task) || stealTask(index, task))
+			execute(task);
+		else
+			std::this_thread::yield();
+	}
+
+	std::exception_ptr error;
+	{
+		std::lock_guard<std::mutex> lock(counter.errorMutex);
+		std::swap(error, counter.error);
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const RangeJob& job) {
+	if (count == 0)
+		return;
+
+	grain = grain ? grain : grainSize;
+
+	size_t rangeSize = grain;
+	if (!deterministic)
+		rangeSize = std::max(grain, (count + getThreadCount() * 4 - 1) / (getThreadCount() * 4));
+
+	size_t rangeCount = (count + rangeSize - 1) / rangeSize;
+
+	if (rangeCount == 1) {
+		job(0, count);
+		return;
+	}
+
+	if (workers.empty()) {
+		for (size_t begin = 0; begin < count; begin += rangeSize)
+			job(begin, std::min(begin + rangeSize, count));
+
+		return;
+	}
+
+	JobCounter counter;
+	for (size_t range = 1; range < rangeCount; ++range) {
+		size_t begin = range * rangeSize;
+		size_t end = std::min(begin + rangeSize, count);
+		submit(counter, [&job, begin, end]() { job(begin, end); });
+	}
+
+	// The queued ranges reference `job` and `counter`, so they have to
+	// finish before an exception from this range unwinds the stack.
+	try {
+		job(0, rangeSize);
+	} catch (...) {
+		wait(counter);
+		throw;
+	}
+
+	wait(counter);
+}
+
+void JobSystem::workerLoop(Uint32 index) {
+	threadIndex = index;
+
+	while (true) {
+		Task task;
+
+		if (popTask(index, task) || stealTask(index, task)) {
+			execute(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		wakeCondition.wait(lock, [this]() {
+			return stopping || queuedTasks.load(std::memory_order_acquire) > 0;
+		});
+
+		if (stopping)
+			return;
+	}
+}
+
+bool JobSystem::popTask(Uint32 index, Task& task) {
+	if (index >= queues.size())
+		return false;
+
+	WorkQueue& queue = *queues[index];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+
+	if (queue.tasks.empty())
+		return false;
+
+	task = std::move(queue.tasks.back());
+	queue.tasks.pop_back();
+	queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+	return true;
+}
+
+bool JobSystem::stealTask(Uint32 thief, Task& task) {
+	size_t queueCount = queues.size();
+
+	for (size_t offset = 1; offset < queueCount; ++offset) {
+		WorkQueue& queue = *queues[(thief + offset) % queueCount];
+		std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+
+		if (!lock.owns_lock() || queue.tasks.empty())
+			continue;
+
+		task = std::move(queue.tasks.front());
+		queue.tasks.pop_front();
+		queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	return false;
+}
+
+void JobSystem::execute(Task& task) {
+	try {
+		task.job();
+	} catch (...) {
+		std::lock_guard<std::mutex> lock(task.counter->errorMutex);
+		if (!task.counter->error)
+			task.counter->error = std::current_exception();
+	}
+
+	task.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace Blackthorn
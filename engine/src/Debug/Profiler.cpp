@@ -22,6 +22,8 @@ void Profiler::beginFrame() {
 	if (!enabled)
 		return;
 
+	std::lock_guard<std::mutex> lock(mutex);
+
 	frameStartTime = SDL_GetPerformanceCounter();
 	currentFrameSamples.clear();
 	scopeStack.clear();
@@ -31,6 +33,8 @@ void Profiler::endFrame() {
 	if (!enabled)
 		return;
 
+	std::lock_guard<std::mutex> lock(mutex);
+
 	Uint64 frameEndTime = SDL_GetPerformanceCounter();
 	lastFrameTime = static_cast<float>(frameEndTime - frameStartTime) / frequency * 1000.0f;
 
@@ -53,6 +57,8 @@ void Profiler::beginScope(const char* name) {
 	if (!enabled)
 		return;
 
+	std::lock_guard<std::mutex> lock(mutex);
+
 	ScopeEntry entry;
 	entry.name = name;
 	entry.startTime = SDL_GetPerformanceCounter();
@@ -65,6 +71,8 @@ void Profiler::endScope(const char* name) {
 	if (!enabled)
 		return;
 
+	std::lock_guard<std::mutex> lock(mutex);
+
 	if (scopeStack.empty()) {
 		#ifdef BLACKTHORN_DEBUG
 			SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Profiler: endScope called without matchin beginScope for %s", name);
@@ -91,6 +99,22 @@ void Profiler::endScope(const char* name) {
 
 }
 
+void Profiler::recordSample(const char* name, Uint64 startTime, Uint64 endTime) {
+	if (!enabled || !name)
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Sample sample;
+	sample.name = name;
+	sample.startTime = startTime;
+	sample.endTime = endTime;
+	sample.duration = static_cast<float>(endTime - startTime) / frequency;
+	sample.depth = static_cast<int>(scopeStack.size());
+
+	currentFrameSamples.push_back(sample);
+}
+
 Profiler::ScopeStats Profiler::getStats(const std::string& name, int frameCount) const {
 	ScopeStats stats = {0.0f, 0.0f, 0.0f, 0.0f, 0};
 
@@ -143,6 +167,8 @@ float Profiler::getAverageFrameTime(int frameCount) const {
 }
 
 void Profiler::clear() {
+	std::lock_guard<std::mutex> lock(mutex);
+
 	scopeHistory.clear();
 	frameTimeHistory.clear();
 	currentFrameSamples.clear();
@@ -0,0 +1,155 @@
+#include "ECS/Systems/VerletKernel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define BLACKTHORN_VERLET_X86
+	#include <immintrin.h>
+#endif
+
+#if defined(BLACKTHORN_VERLET_X86) && (defined(__GNUC__) || defined(__clang__))
+	#define BLACKTHORN_VERLET_AVX
+#endif
+
+namespace Blackthorn::ECS::Systems {
+
+namespace {
+
+using Components::Kinematics;
+using Components::Transform;
+
+// The vector paths load a whole component as four floats:
+// Transform as (x, y, angle, scale), Kinematics as (oldX, oldY, accX, accY).
+static_assert(sizeof(Transform) == 4 * sizeof(float) && offsetof(Transform, position) == 0);
+static_assert(sizeof(Kinematics) == 4 * sizeof(float) && offsetof(Kinematics, oldPosition) == 0);
+static_assert(offsetof(Kinematics, acceleration) == 2 * sizeof(float));
+
+void integrateScalar(Transform* transforms, Kinematics* kinematics, size_t count, float dt2, size_t begin) {
+	for (size_t i = begin; i < count; ++i) {
+		Transform& t = transforms[i];
+		Kinematics& k = kinematics[i];
+		float x = t.position.x;
+		float y = t.position.y;
+
+		t.position.x = x * 2.0f - k.oldPosition.x + k.acceleration.x * dt2;
+		t.position.y = y * 2.0f - k.oldPosition.y + k.acceleration.y * dt2;
+		k.oldPosition.x = x;
+		k.oldPosition.y = y;
+		k.acceleration.x *= 0.0f;
+		k.acceleration.y *= 0.0f;
+	}
+}
+
+#ifdef BLACKTHORN_VERLET_X86
+void integrateSSE(Transform* transforms, Kinematics* kinematics, size_t count, float dt2) {
+	const __m128 two = _mm_set1_ps(2.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 step = _mm_set1_ps(dt2);
+
+	for (size_t i = 0; i < count; ++i) {
+		float* t = &transforms[i].position.x;
+		float* k = &kinematics[i].oldPosition.x;
+
+		__m128 current = _mm_loadu_ps(t);
+		__m128 state = _mm_loadu_ps(k);
+		__m128 acceleration = _mm_movehl_ps(state, state);
+
+		// Only the low two lanes of `next` are meaningful.
+		__m128 next = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(current, two), state), _mm_mul_ps(acceleration, step));
+		__m128 cleared = _mm_mul_ps(state, zero);
+
+		_mm_storeu_ps(t, _mm_shuffle_ps(next, current, _MM_SHUFFLE(3, 2, 1, 0)));
+		_mm_storeu_ps(k, _mm_shuffle_ps(current, cleared, _MM_SHUFFLE(3, 2, 1, 0)));
+	}
+}
+#endif
+
+#ifdef BLACKTHORN_VERLET_AVX
+__attribute__((target("avx")))
+void integrateAVX(Transform* transforms, Kinematics* kinematics, size_t count, float dt2) {
+	const __m256 two = _mm256_set1_ps(2.0f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 step = _mm256_set1_ps(dt2);
+
+	// Two bodies per register; blend mask 0b11001100 picks lanes 2-3 of each half.
+	size_t i = 0;
+	for (; i + 2 <= count; i += 2) {
+		float* t = &transforms[i].position.x;
+		float* k = &kinematics[i].oldPosition.x;
+
+		__m256 current = _mm256_loadu_ps(t);
+		__m256 state = _mm256_loadu_ps(k);
+		__m256 acceleration = _mm256_permute_ps(state, _MM_SHUFFLE(3, 2, 3, 2));
+
+		__m256 next = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(current, two), state), _mm256_mul_ps(acceleration, step));
+		__m256 cleared = _mm256_mul_ps(state, zero);
+
+		_mm256_storeu_ps(t, _mm256_blend_ps(next, current, 0b11001100));
+		_mm256_storeu_ps(k, _mm256_blend_ps(current, cleared, 0b11001100));
+	}
+
+	integrateScalar(transforms, kinematics, count, dt2, i);
+}
+#endif
+
+VerletKernel::Level supportedLevel() {
+	#if defined(BLACKTHORN_VERLET_AVX)
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx"))
+			return VerletKernel::Level::AVX;
+
+		if (__builtin_cpu_supports("sse2"))
+			return VerletKernel::Level::SSE;
+
+		return VerletKernel::Level::Scalar;
+	#elif defined(BLACKTHORN_VERLET_X86)
+		return VerletKernel::Level::SSE;
+	#else
+		return VerletKernel::Level::Scalar;
+	#endif
+}
+
+std::atomic<VerletKernel::Level>& activeLevel() {
+	static std::atomic<VerletKernel::Level> level{supportedLevel()};
+	return level;
+}
+
+} // namespace
+
+void VerletKernel::integrate(Components::Transform* transforms, Components::Kinematics* kinematics, size_t count, float dt2) {
+	switch (activeLevel().load(std::memory_order_relaxed)) {
+	#ifdef BLACKTHORN_VERLET_AVX
+		case Level::AVX:
+			integrateAVX(transforms, kinematics, count, dt2);
+			return;
+	#endif
+
+	#ifdef BLACKTHORN_VERLET_X86
+		case Level::SSE:
+			integrateSSE(transforms, kinematics, count, dt2);
+			return;
+	#endif
+
+		default:
+			integrateScalar(transforms, kinematics, count, dt2, 0);
+			return;
+	}
+}
+
+VerletKernel::Level VerletKernel::detectLevel() {
+	static const Level level = supportedLevel();
+	return level;
+}
+
+void VerletKernel::setLevel(Level level) {
+	activeLevel().store(std::min(level, detectLevel()), std::memory_order_relaxed);
+}
+
+VerletKernel::Level VerletKernel::getLevel() {
+	return activeLevel().load(std::memory_order_relaxed);
+}
+
+} // namespace Blackthorn::ECS::Systems
@@ -0,0 +1,64 @@
+#include "ECS/TypeRegistry.h"
+
+#include <mutex>
+#include <stdexcept>
+
+#include "ECS/Detail.h"
+
+namespace Blackthorn::ECS {
+
+size_t TypeRegistry::assure(TypeHash hash, std::string_view name) {
+	{
+		std::shared_lock lock(mutex);
+		auto it = lookup.find(hash);
+
+		if (it != lookup.end() && types[it->second].name == name)
+			return it->second;
+	}
+
+	std::unique_lock lock(mutex);
+	auto it = lookup.find(hash);
+
+	if (it != lookup.end()) {
+		if (types[it->second].name != name)
+			throw std::runtime_error("ECS: Type hash collision between " + types[it->second].name + " and " + std::string(name));
+
+		return it->second;
+	}
+
+	if (types.size() >= Detail::MAX_COMPONENTS)
+		throw std::runtime_error("ECS: Too many component types, raise BLACKTHORN_MAX_COMPONENTS");
+
+	size_t id = types.size();
+	types.push_back(Entry{ hash, std::string(name) });
+	lookup.emplace(hash, id);
+	return id;
+}
+
+size_t TypeRegistry::find(TypeHash hash) const {
+	std::shared_lock lock(mutex);
+	auto it = lookup.find(hash);
+	return it != lookup.end() ? it->second : NO_TYPE;
+}
+
+std::string_view TypeRegistry::name(size_t id) const {
+	std::shared_lock lock(mutex);
+	return id < types.size() ? std::string_view(types[id].name) : std::string_view();
+}
+
+TypeHash TypeRegistry::hash(size_t id) const {
+	std::shared_lock lock(mutex);
+	return id < types.size() ? types[id].hash : 0;
+}
+
+size_t TypeRegistry::size() const {
+	std::shared_lock lock(mutex);
+	return types.size();
+}
+
+TypeRegistry& TypeRegistry::global() {
+	static TypeRegistry registry;
+	return registry;
+}
+
+} // namespace Blackthorn::ECS
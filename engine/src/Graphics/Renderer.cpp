@@ -1,5 +1,8 @@
 #include "Graphics/Renderer.h"
 
+#include <algorithm>
+#include <bit>
+
 #include <glm/gtc/type_ptr.hpp>
 
 namespace Blackthorn::Graphics {
@@ -12,13 +15,27 @@ inline constexpr glm::vec2 Renderer::toGLMVec2(float x, float y) {
 	return glm::vec2(x, y);
 }
 
+inline std::array<Uint8, 4> Renderer::toRGBA8(const SDL_FColor& color) {
+	auto channel = [](float value) {
+		return static_cast<Uint8>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	};
+
+	return { channel(color.r), channel(color.g), channel(color.b), channel(color.a) };
+}
+
+inline Uint16 Renderer::toUNorm16(float value) {
+	return static_cast<Uint16>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
 Renderer::Renderer()
 	: projectionMatrix(1.0f)
 	, viewMatrix(1.0f)
 {
 	quadBuffer = std::make_unique<Vertex2D[]>(MAX_VERTICES);
+	instanceBuffer = std::make_unique<SpriteInstance[]>(MAX_QUADS);
 
 	initQuadBuffers();
+	initInstanceBuffers();
 	initShader();
 
 	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -29,13 +46,17 @@ Renderer::Renderer()
 	globalUBO = std::make_unique<UBO<GlobalData>>();
 	globalUBO->bind(0);
 
-	GLuint blockIndex = glGetUniformBlockIndex(shader->id(), "GlobalData");
-	if (blockIndex != GL_INVALID_INDEX)
-		glUniformBlockBinding(shader->id(), blockIndex, 0);
+	for (const Shader* program : { shader.get(), arrayShader.get(), instancedShader.get(), instancedArrayShader.get() }) {
+		GLuint blockIndex = glGetUniformBlockIndex(program->id(), "GlobalData");
+		if (blockIndex != GL_INVALID_INDEX)
+			glUniformBlockBinding(program->id(), blockIndex, 0);
+	}
 
 	textureSlots.fill(nullptr);
 	textureSlots[0] = whiteTexture.get();
 
+	layerSortModes.fill(SortMode::Batched);
+
 	#ifdef BLACKTHORN_DEBUG
 		SDL_Log("Renderer initialized (Max Quads: %u, Max Textures: %u)", MAX_QUADS, MAX_TEXTURE_SLOTS);
 	#endif
@@ -84,6 +105,48 @@ void Renderer::initQuadBuffers() {
 	#endif
 }
 
+void Renderer::initInstanceBuffers() {
+	InstanceVAO = std::make_unique<VAO>(true);
+	CornerVBO = std::make_unique<VBO>(true);
+	InstanceVBO = std::make_unique<VBO>(true);
+
+	InstanceVAO->bind();
+
+	// Same winding as the batched quads, so the quad EBO's first six
+	// indices draw every instance.
+	constexpr glm::vec2 corners[4] = {
+		{ 0.0f, 0.0f },
+		{ 1.0f, 0.0f },
+		{ 1.0f, 1.0f },
+		{ 0.0f, 1.0f }
+	};
+
+	CornerVBO->bind();
+	glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+	InstanceVAO->enableAttrib(0, 2, GL_FLOAT, sizeof(glm::vec2), 0);
+
+	InstanceVBO->bind();
+	glBufferData(GL_ARRAY_BUFFER, MAX_QUADS * sizeof(SpriteInstance), nullptr, GL_DYNAMIC_DRAW);
+
+	InstanceVAO->enableAttrib(1, 2, GL_FLOAT, sizeof(SpriteInstance), offsetof(SpriteInstance, center));
+	InstanceVAO->enableAttrib(2, 2, GL_FLOAT, sizeof(SpriteInstance), offsetof(SpriteInstance, size));
+	InstanceVAO->enableAttrib(3, 1, GL_FLOAT, sizeof(SpriteInstance), offsetof(SpriteInstance, rotation));
+	InstanceVAO->enableAttrib(4, 1, GL_FLOAT, sizeof(SpriteInstance), offsetof(SpriteInstance, z));
+	InstanceVAO->enableAttrib(5, 4, GL_UNSIGNED_SHORT, sizeof(SpriteInstance), offsetof(SpriteInstance, uvRect), true);
+	InstanceVAO->enableAttrib(6, 4, GL_UNSIGNED_BYTE, sizeof(SpriteInstance), offsetof(SpriteInstance, color), true);
+	InstanceVAO->enableAttrib(7, 1, GL_FLOAT, sizeof(SpriteInstance), offsetof(SpriteInstance, texIndex));
+
+	for (GLuint i = 1; i <= 7; ++i)
+		InstanceVAO->setAttribDivisor(i, 1);
+
+	QuadEBO->bind();
+	VAO::unbind();
+
+	#ifdef BLACKTHORN_DEBUG
+		SDL_Log("Renderer Instance buffers initialized");
+	#endif
+}
+
 void Renderer::initShader() {
 	shader = std::make_unique<Shader>("assets/shaders/default.vert", "assets/shaders/default.frag");
 	shader->bind();
@@ -92,6 +155,21 @@ void Renderer::initShader() {
 		shader->setInt("u_Textures[" + std::to_string(i) + "]", i);
 	}
 
+	arrayShader = std::make_unique<Shader>("assets/shaders/default.vert", "assets/shaders/array.frag");
+	arrayShader->bind();
+	arrayShader->setInt("u_TextureArray", 0);
+
+	instancedShader = std::make_unique<Shader>("assets/shaders/instanced.vert", "assets/shaders/default.frag");
+	instancedShader->bind();
+
+	for (Uint32 i = 0; i < MAX_TEXTURE_SLOTS; ++i) {
+		instancedShader->setInt("u_Textures[" + std::to_string(i) + "]", i);
+	}
+
+	instancedArrayShader = std::make_unique<Shader>("assets/shaders/instanced.vert", "assets/shaders/array.frag");
+	instancedArrayShader->bind();
+	instancedArrayShader->setInt("u_TextureArray", 0);
+
 	#ifdef BLACKTHORN_DEBUG
 		SDL_Log("Renderer Shader initialized");
 	#endif
@@ -103,6 +181,7 @@ void Renderer::initWhiteTexture() {
 
 void Renderer::startBatch() {
 	quadBufferPtr = quadBuffer.get();
+	instanceBufferPtr = instanceBuffer.get();
 	quadIndexCount = 0;
 	textureSlotIndex = 1;
 
@@ -119,6 +198,28 @@ void Renderer::flush() {
 	if (quadIndexCount == 0)
 		return;
 
+	if (batchArray) {
+		batchArray->bind(0);
+	} else {
+		for (Uint32 i = 0; i < textureSlotIndex; ++i) {
+			if (textureSlots[i])
+				textureSlots[i]->bind(i);
+		}
+	}
+
+	if (instancingEnabled) {
+		Uint32 instanceCount = quadIndexCount / 6;
+
+		InstanceVBO->bind();
+		glBufferSubData(GL_ARRAY_BUFFER, 0, instanceCount * sizeof(SpriteInstance), instanceBuffer.get());
+
+		(batchArray ? instancedArrayShader : instancedShader)->bind();
+		InstanceVAO->bind();
+
+		glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, instanceCount);
+		return;
+	}
+
 	Uint32 dataSize = static_cast<Uint32>(
 		reinterpret_cast<Uint8*>(quadBufferPtr) - reinterpret_cast<Uint8*>(quadBuffer.get())
 	);
@@ -127,35 +228,119 @@ void Renderer::flush() {
 	QuadVBO->bind();
 	glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, quadBuffer.get());
 
-	for (Uint32 i = 0; i < textureSlotIndex; ++i) {
-		if (textureSlots[i])
-			textureSlots[i]->bind(i);
-	}
-
-	shader->bind();
+	(batchArray ? arrayShader : shader)->bind();
 	QuadVAO->bind();
 
 	glDrawElements(GL_TRIANGLES, quadIndexCount, GL_UNSIGNED_INT, nullptr);
 }
 
 void Renderer::beginScene() {
+	commands.clear();
+	sortEntries.clear();
 	startBatch();
 }
 
 void Renderer::endScene() {
+	sortCommands();
+
+	for (const SortEntry& entry : sortEntries)
+		emit(commands[entry.index]);
+
 	flush();
+
+	commands.clear();
+	sortEntries.clear();
+}
+
+Uint64 Renderer::sortKey(float z, const Texture* texture, const TextureArray* array) const {
+	// Flipping the sign bit (or every bit of a negative) makes unsigned
+	// order match float order.
+	Uint32 depth = std::bit_cast<Uint32>(z);
+	depth ^= (depth & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u;
+
+	Uint64 key = (static_cast<Uint64>(currentLayer) << 56) | (static_cast<Uint64>(depth) << 24);
+
+	if (layerSortModes[currentLayer] == SortMode::Stable)
+		return key;
+
+	if (array)
+		key |= (static_cast<Uint64>(1) << 16) | (array->getID() & 0xFFFFu);
+	else if (texture)
+		key |= texture->getID() & 0xFFFFu;
+
+	return key;
+}
+
+void Renderer::sortCommands() {
+	size_t count = sortEntries.size();
+
+	if (count < 2)
+		return;
+
+	// Least significant byte first; each pass is stable, so commands with
+	// equal keys keep their submission order. All eight histograms come out
+	// of one read of the keys.
+	std::array<std::array<Uint32, 256>, 8> histograms{};
+
+	for (const SortEntry& entry : sortEntries) {
+		for (Uint32 pass = 0; pass < 8; ++pass)
+			++histograms[pass][(entry.key >> (pass * 8)) & 0xFF];
+	}
+
+	sortScratch.resize(count);
+
+	for (Uint32 pass = 0; pass < 8; ++pass) {
+		Uint32 shift = pass * 8;
+		auto& offsets = histograms[pass];
+
+		// Every key shares this byte, so the pass wouldn't move anything.
+		if (offsets[(sortEntries.front().key >> shift) & 0xFF] == count)
+			continue;
+
+		Uint32 offset = 0;
+		for (Uint32& bucket : offsets) {
+			Uint32 size = bucket;
+			bucket = offset;
+			offset += size;
+		}
+
+		for (const SortEntry& entry : sortEntries)
+			sortScratch[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+
+		sortEntries.swap(sortScratch);
+	}
 }
 
 void Renderer::draw(const SDL_FRect& rect, float z, float rotation, const SDL_FColor& color, const Texture* texture, const SDL_FRect* srcRect) {
 	if (!isVisible(rect, rotation))
 		return;
 
-	if (quadIndexCount >= MAX_INDICES)
+	// Untextured quads use the array's white layer.
+	int arrayLayer = -1;
+	if (textureArray)
+		arrayLayer = texture ? textureArray->findLayer(*texture) : 0;
+
+	const TextureArray* array = arrayLayer >= 0 ? textureArray : nullptr;
+
+	Uint32 index = static_cast<Uint32>(commands.size());
+	commands.push_back(DrawCommand{ rect, srcRect ? *srcRect : SDL_FRect{}, color, texture, z, rotation, array, arrayLayer, srcRect != nullptr });
+	sortEntries.push_back(SortEntry{ sortKey(z, texture, array), index });
+}
+
+void Renderer::emit(const DrawCommand& command) {
+	const SDL_FRect& rect = command.rect;
+	const Texture* texture = command.texture;
+	float z = command.z;
+	float rotation = command.rotation;
+	if (quadIndexCount >= MAX_INDICES || (quadIndexCount > 0 && command.array != batchArray))
 		nextBatch();
 
+	batchArray = command.array;
 	float texIndex = 0.0f;
 
-	if (texture) {
+	if (batchArray) {
+		texIndex = static_cast<float>(command.arrayLayer);
+	} else if (texture) {
 		bool found = false;
 		for (Uint32 i = 1; i < textureSlotIndex; ++i) {
 			if (textureSlots[i] == texture) {
@@ -175,8 +360,6 @@ void Renderer::draw(const SDL_FRect& rect, float z, float rotation, const SDL_FC
 		}
 	}
 
-	glm::vec4 glmColor = toGLMColor(color);
-
 	glm::vec2 textureCoords[4];
 	constexpr glm::vec2 defaultTexCoords[4] = {
 		{ 0.0f, 1.0f },
@@ -185,14 +368,15 @@ void Renderer::draw(const SDL_FRect& rect, float z, float rotation, const SDL_FC
 		{ 0.0f, 0.0f }
 	};
 
-	if (srcRect && texture) {
+	if (command.hasSrc && texture) {
+		const SDL_FRect& srcRect = command.src;
 		float invTexWidth = 1.0f / texture->getWidth();
 		float invTexHeight = 1.0f / texture->getHeight();
 
-		float u0 = srcRect->x * invTexWidth;
-		float v0 = 1.0f - (srcRect->y * invTexHeight);
-		float u1 = (srcRect->x + srcRect->w) * invTexWidth;
-		float v1 = 1.0f - ((srcRect->y + srcRect->h) * invTexHeight);
+		float u0 = srcRect.x * invTexWidth;
+		float v0 = 1.0f - (srcRect.y * invTexHeight);
+		float u1 = (srcRect.x + srcRect.w) * invTexWidth;
+		float v1 = 1.0f - ((srcRect.y + srcRect.h) * invTexHeight);
 
 		textureCoords[0] = { u0, v1 };
 		textureCoords[1] = { u1, v1 };
@@ -202,6 +386,27 @@ void Renderer::draw(const SDL_FRect& rect, float z, float rotation, const SDL_FC
 		std::memcpy(textureCoords, defaultTexCoords, sizeof(textureCoords));
 	}
 
+	// Instances keep the first and third corner's UVs; the shader
+	// interpolates the other two.
+	if (instancingEnabled) {
+		SpriteInstance& instance = *instanceBufferPtr++;
+		instance.center = { rect.x + rect.w * 0.5f, rect.y + rect.h * 0.5f };
+		instance.size = { rect.w, rect.h };
+		instance.rotation = rotation;
+		instance.z = z;
+		instance.uvRect = {
+			toUNorm16(textureCoords[0].x), toUNorm16(textureCoords[0].y),
+			toUNorm16(textureCoords[2].x), toUNorm16(textureCoords[2].y)
+		};
+		instance.color = toRGBA8(command.color);
+		instance.texIndex = texIndex;
+
+		quadIndexCount += 6;
+		return;
+	}
+
+	glm::vec4 glmColor = toGLMColor(command.color);
+
 	if (rotation != 0.0f) {
 		float centerX = rect.x + rect.w * 0.5f;
 		float centerY = rect.y + rect.h * 0.5f;
@@ -0,0 +1,175 @@
+#include "Graphics/TextureArray.h"
+
+#include <vector>
+
+namespace Blackthorn::Graphics {
+
+void TextureArray::applyParams() {
+	if (id == 0)
+		return;
+
+	bind();
+
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, params.generateMipmaps ? GL_LINEAR_MIPMAP_LINEAR : Texture::toGLFilter(params.minFilter));
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, Texture::toGLFilter(params.magFilter));
+
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, Texture::toGLWrap(params.wrapS));
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, Texture::toGLWrap(params.wrapT));
+}
+
+TextureArray::TextureArray(int w, int h, int layerCapacity, const TextureParams& parameters) {
+	create(w, h, layerCapacity, parameters);
+}
+
+TextureArray::~TextureArray() {
+	destroy();
+}
+
+TextureArray::TextureArray(TextureArray&& other) noexcept
+	: id(other.id)
+	, width(other.width)
+	, height(other.height)
+	, capacity(other.capacity)
+	, layerCount(other.layerCount)
+	, params(other.params)
+	, layers(std::move(other.layers))
+{
+	other.id = 0;
+	other.width = 0;
+	other.height = 0;
+	other.capacity = 0;
+	other.layerCount = 0;
+	other.layers.clear();
+}
+
+TextureArray& TextureArray::operator=(TextureArray&& other) noexcept {
+	if (this != &other) {
+		destroy();
+
+		id = other.id;
+		width = other.width;
+		height = other.height;
+		capacity = other.capacity;
+		layerCount = other.layerCount;
+		params = other.params;
+		layers = std::move(other.layers);
+
+		other.id = 0;
+		other.width = 0;
+		other.height = 0;
+		other.capacity = 0;
+		other.layerCount = 0;
+		other.layers.clear();
+	}
+
+	return *this;
+}
+
+bool TextureArray::create(int w, int h, int layerCapacity, const TextureParams& parameters) {
+	destroy();
+
+	if (w <= 0 || h <= 0 || layerCapacity < 1) {
+		#ifdef BLACKTHORN_DEBUG
+			SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Invalid texture array dimensions");
+		#endif
+
+		return false;
+	}
+
+	params = parameters;
+	width = w;
+	height = h;
+	capacity = layerCapacity;
+
+	glGenTextures(1, &id);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+	glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, capacity, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+	applyParams();
+
+	std::vector<Uint8> white(static_cast<size_t>(width) * height * 4, 255);
+	addLayer(white.data());
+
+	return true;
+}
+
+void TextureArray::destroy() {
+	if (id != 0) {
+		glDeleteTextures(1, &id);
+		id = 0;
+		width = 0;
+		height = 0;
+		capacity = 0;
+		layerCount = 0;
+		layers.clear();
+	}
+}
+
+int TextureArray::addLayer(const void* pixels) {
+	if (id == 0 || pixels == nullptr || layerCount >= capacity) {
+		#ifdef BLACKTHORN_DEBUG
+			SDL_LogError(SDL_LOG_CATEGORY_RENDER, "Cannot add layer to texture array (%d of %d layers used)", layerCount, capacity);
+		#endif
+
+		return -1;
+	}
+
+	int layer = layerCount++;
+
+	bind();
+	glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+	if (params.generateMipmaps)
+		glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+
+	return layer;
+}
+
+int TextureArray::add(const Texture& texture) {
+	int existing = findLayer(texture);
+	if (existing >= 0)
+		return existing;
+
+	if (!texture.isValid() || texture.getWidth() != width || texture.getHeight() != height) {
+		#ifdef BLACKTHORN_DEBUG
+			SDL_LogError(
+				SDL_LOG_CATEGORY_RENDER,
+				"Cannot pack %d x %d texture into %d x %d texture array",
+				texture.getWidth(), texture.getHeight(), width, height
+			);
+		#endif
+
+		return -1;
+	}
+
+	// Read back as RGBA8 whatever the source format, so every layer matches.
+	std::vector<Uint8> pixels(static_cast<size_t>(width) * height * 4);
+	texture.bind();
+	glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+	int layer = addLayer(pixels.data());
+	if (layer >= 0)
+		layers[texture.getID()] = layer;
+
+	return layer;
+}
+
+int TextureArray::findLayer(const Texture& texture) const {
+	auto it = layers.find(texture.getID());
+	return it != layers.end() ? it->second : -1;
+}
+
+void TextureArray::bind(GLuint slot) const {
+	if (id == 0) {
+		#ifdef BLACKTHORN_DEBUG
+			SDL_LogWarn(SDL_LOG_CATEGORY_RENDER, "Attempting to bind invalid texture array");
+		#endif
+
+		return;
+	}
+
+	glActiveTexture(GL_TEXTURE0 + slot);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+}
+
+} // namespace Blackthorn::Graphics
@@ -108,6 +108,9 @@ void VAO::enableAttrib(GLuint index, GLint size, GLenum type, GLsizei stride, si
 			case GL_UNSIGNED_BYTE:
 				typeStr = "GL_UNSIGNED_BYTE";
 				break;
+			case GL_UNSIGNED_SHORT:
+				typeStr = "GL_UNSIGNED_SHORT";
+				break;
 		}
 		SDL_Log("VAO %u: Enabled attribute %u (size=%d, type=%s, stride=%d, offset=%lld, normalized=%u)",
 		id, index, size, typeStr, stride, offset, normalized);
@@ -143,6 +146,31 @@ void VAO::disableAttrib(GLuint index) {
 	#endif
 }
 
+void VAO::setAttribDivisor(GLuint index, GLuint divisor) {
+	if (id == 0) {
+		#ifdef BLACKTHORN_DEBUG
+			SDL_LogError(SDL_LOG_CATEGORY_RENDER,
+				"Cannot set attribute divisor on uninitialized VAO"
+			);
+		#endif
+
+		return;
+	}
+
+	if (!isBound()) {
+		#ifdef BLACKTHORN_DEBUG
+			SDL_LogWarn(SDL_LOG_CATEGORY_RENDER,
+				"Setting VAO %u attribute divisor while not bound",
+				id
+			);
+		#endif
+
+		bind();
+	}
+
+	glVertexAttribDivisor(index, divisor);
+}
+
 void VAO::destroy() {
 	if (id != 0) {
 		glDeleteVertexArrays(1, &id);
@@ -0,0 +1,53 @@
+#include "Utils/StringInterner.h"
+
+#include <mutex>
+
+namespace Utils {
+
+StringInterner::StringInterner() {
+	intern("");
+}
+
+Symbol StringInterner::intern(std::string_view text) {
+	{
+		std::shared_lock lock(mutex);
+		auto it = lookup.find(text);
+
+		if (it != lookup.end())
+			return it->second;
+	}
+
+	std::unique_lock lock(mutex);
+	auto it = lookup.find(text);
+
+	if (it != lookup.end())
+		return it->second;
+
+	Symbol symbol = static_cast<Symbol>(strings.size());
+	const std::string& stored = strings.emplace_back(text);
+	lookup.emplace(stored, symbol);
+	return symbol;
+}
+
+Symbol StringInterner::find(std::string_view text) const {
+	std::shared_lock lock(mutex);
+	auto it = lookup.find(text);
+	return it != lookup.end() ? it->second : INVALID_SYMBOL;
+}
+
+std::string_view StringInterner::resolve(Symbol symbol) const {
+	std::shared_lock lock(mutex);
+	return symbol < strings.size() ? std::string_view(strings[symbol]) : std::string_view();
+}
+
+size_t StringInterner::size() const {
+	std::shared_lock lock(mutex);
+	return strings.size();
+}
+
+StringInterner& StringInterner::global() {
+	static StringInterner interner;
+	return interner;
+}
+
+} // namespace Utils
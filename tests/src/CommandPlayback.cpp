@@ -0,0 +1,123 @@
+// Command playback: each type's inserts land in one batch, the last recorded
+// value wins, and commands that observers record while a buffer plays back
+// are kept for the next playback rather than dropped.
+
+#include <cstdio>
+#include <vector>
+
+#include "ECS/EntityPool.h"
+
+namespace {
+
+using namespace Blackthorn;
+using namespace Blackthorn::ECS;
+
+constexpr int ENTITY_COUNT = 1000;
+
+struct Health {
+	int value = 0;
+};
+
+struct Armor {
+	int value = 0;
+};
+
+struct Shield {
+	int value = 0;
+};
+
+bool check(bool condition, const char* mode, const char* what) {
+	if (!condition)
+		std::printf("%s: %s\n", mode, what);
+
+	return condition;
+}
+
+bool run(StorageMode mode, const char* name) {
+	EntityPool pool(64, mode);
+	bool passed = true;
+
+	std::vector<Entity> existing(ENTITY_COUNT);
+	pool.createMany(existing);
+
+	for (int i = 0; i < ENTITY_COUNT; i += 2)
+		pool.addComponent<Health>(existing[i], -1);
+
+	size_t added = 0;
+	size_t replaced = 0;
+
+	// Every new Health earns a Shield, recorded from inside playback.
+	pool.onAdd<Health>([&](EntityPool& p, std::span<const Entity> targets) {
+		added += targets.size();
+
+		for (Entity entity : targets)
+			p.commands().add<Shield>(entity, p.getComponent<Health>(entity)->value * 2);
+	});
+
+	pool.onReplace<Health>([&](EntityPool&, std::span<const Entity> targets) {
+		replaced += targets.size();
+	});
+
+	CommandBuffer& commands = pool.commands();
+
+	for (int i = 0; i < ENTITY_COUNT; ++i) {
+		commands.add<Health>(existing[i], 0);
+		commands.add<Health>(existing[i], i);
+		commands.add<Armor>(existing[i], i + 1);
+	}
+
+	std::vector<PendingEntity> pending;
+
+	for (int i = 0; i < ENTITY_COUNT; ++i) {
+		pending.push_back(commands.create());
+		commands.add<Armor>(pending.back(), -i);
+		commands.add<Health>(pending.back(), ENTITY_COUNT + i);
+	}
+
+	pool.playbackCommands();
+
+	passed = check(added == ENTITY_COUNT + ENTITY_COUNT / 2, name, "wrong add event count") && passed;
+	passed = check(replaced == ENTITY_COUNT / 2, name, "wrong replace event count") && passed;
+	passed = check(pool.aliveCount() == 2 * ENTITY_COUNT, name, "wrong entity count") && passed;
+	passed = check(!pool.commands().empty(), name, "commands recorded during playback were dropped") && passed;
+
+	size_t shields = 0;
+	pool.view<const Shield>().each([&](Entity, const Shield&) { ++shields; });
+	passed = check(shields == 0, name, "commands recorded during playback were applied early") && passed;
+
+	for (int i = 0; i < ENTITY_COUNT; ++i) {
+		const Health* health = pool.getComponent<Health>(existing[i]);
+		const Armor* armor = pool.getComponent<Armor>(existing[i]);
+
+		if (!health || health->value != i || !armor || armor->value != i + 1) {
+			passed = check(false, name, "existing entity has the wrong values") && passed;
+			break;
+		}
+	}
+
+	pool.playbackCommands();
+
+	passed = check(pool.commands().empty(), name, "commands left after the second playback") && passed;
+
+	size_t matching = 0;
+	pool.view<const Health, const Armor, const Shield>().each([&](Entity, const Health& health, const Armor& armor, const Shield& shield) {
+		bool fresh = health.value >= ENTITY_COUNT;
+		int expectedArmor = fresh ? ENTITY_COUNT - health.value : health.value + 1;
+
+		if (armor.value == expectedArmor && shield.value == health.value * 2)
+			++matching;
+	});
+
+	passed = check(matching == ENTITY_COUNT + ENTITY_COUNT / 2, name, "shields don't match their health") && passed;
+
+	std::printf("%s: %zu adds, %zu replaces, %zu shields %s\n", name, added, replaced, matching, passed ? "applied" : "WRONG");
+	return passed;
+}
+
+} // namespace
+
+int main() {
+	bool passed = run(StorageMode::SparseSet, "SparseSet");
+	passed = run(StorageMode::Archetype, "Archetype") && passed;
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,265 @@
+// Rollback over a local loopback link: one peer predicts the other's input,
+// and when the real input arrives late it restores the snapshot of that
+// frame and re-simulates up to the present. The result must match a world
+// that knew every input on time, bit for bit.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ECS/Components/Kinematics.h"
+#include "ECS/Components/Transform.h"
+#include "ECS/Snapshot.h"
+#include "ECS/Systems/KinematicsSystem.h"
+#include "ECS/World.h"
+
+namespace {
+
+using namespace Blackthorn;
+using namespace Blackthorn::ECS;
+using namespace Blackthorn::ECS::Components;
+
+constexpr Uint64 FRAME_COUNT = 600;
+constexpr float FIXED_STEP = 1.0f / 60.0f;
+
+// An input sent on frame f arrives on frame f + LATENCY, so the peer restores
+// frame f and steps it and the LATENCY frames after it: 8 frames, the full
+// depth of the history.
+constexpr Uint64 LATENCY = 7;
+constexpr size_t ROLLBACK_FRAMES = LATENCY + 1;
+
+struct Input {
+	Sint8 x = 0;
+	Sint8 y = 0;
+	bool fire = false;
+
+	bool operator==(const Input&) const = default;
+};
+
+struct Projectile {
+	int framesLeft = 0;
+};
+
+// Holds each input for a few frames, like a player would.
+Input inputFor(int player, Uint64 frame) {
+	Uint32 hash = static_cast<Uint32>(frame / 5) * 2654435761u + static_cast<Uint32>(player) * 40503u;
+	hash ^= hash >> 13;
+	hash *= 0x5BD1E995u;
+	hash ^= hash >> 15;
+
+	return Input{
+		static_cast<Sint8>(static_cast<int>(hash % 3) - 1),
+		static_cast<Sint8>(static_cast<int>((hash >> 4) % 3) - 1),
+		(hash >> 8) % 4 == 0
+	};
+}
+
+class Match {
+private:
+	World world;
+	Entity players[2];
+
+public:
+	explicit Match(StorageMode mode)
+		: world(64, mode)
+	{
+		world.addSystem<Systems::KinematicsSystem>();
+		world.registerComponent<Projectile>();
+
+		for (int i = 0; i < 2; ++i) {
+			players[i] = world.createEntity();
+			world.addComponent<Transform>(players[i], 100.0f + 200.0f * i, 100.0f);
+			world.addComponent<Kinematics>(players[i], 100.0f + 200.0f * i, 100.0f);
+		}
+
+		// Background bodies, so the snapshot isn't only the players.
+		for (int i = 0; i < 500; ++i) {
+			Entity body = world.createEntity();
+			world.addComponent<Transform>(body, static_cast<float>(i), static_cast<float>(i % 17));
+			world.addComponent<Kinematics>(body, i - 0.25f, (i % 17) + 0.5f);
+		}
+	}
+
+	void step(const Input (&inputs)[2]) {
+		for (int i = 0; i < 2; ++i) {
+			Kinematics* k = world.getComponent<Kinematics>(players[i]);
+			k->acceleration = glm::vec2(inputs[i].x, inputs[i].y) * 600.0f;
+
+			if (!inputs[i].fire)
+				continue;
+
+			glm::vec2 position = world.getComponent<Transform>(players[i])->position;
+			Entity shot = world.createEntity();
+			world.addComponent<Transform>(shot, position);
+			world.addComponent<Kinematics>(shot, position - glm::vec2(0.0f, 4.0f));
+			world.addComponent<Projectile>(shot, 20 + 10 * i);
+		}
+
+		std::vector<Entity> expired;
+		world.view<Projectile>().each([&](Entity entity, Projectile& projectile) {
+			if (--projectile.framesLeft <= 0)
+				expired.push_back(entity);
+		});
+
+		for (Entity entity : expired)
+			world.destroyEntity(entity);
+
+		world.fixedUpdate(FIXED_STEP);
+	}
+
+	// Every live entity with its exact position bits, in entity order.
+	std::string state() {
+		std::vector<std::pair<Entity, glm::vec2>> bodies;
+		world.view<const Transform>().each([&](Entity entity, const Transform& t) {
+			bodies.emplace_back(entity, t.position);
+		});
+
+		std::sort(bodies.begin(), bodies.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		std::string bytes(bodies.size() * sizeof(bodies[0]), '\0');
+		if (!bodies.empty())
+			std::memcpy(bytes.data(), bodies.data(), bytes.size());
+
+		return bytes;
+	}
+
+	World& getWorld() { return world; }
+};
+
+// Stands in for the network: delivers each input LATENCY frames after it was sent.
+class Loopback {
+private:
+	std::deque<std::pair<Uint64, Input>> inFlight;
+
+public:
+	void send(Uint64 frame, Input input) {
+		inFlight.emplace_back(frame, input);
+	}
+
+	template <typename Function>
+	void receive(Uint64 now, Function&& function) {
+		while (!inFlight.empty() && inFlight.front().first + LATENCY <= now) {
+			function(inFlight.front().first, inFlight.front().second);
+			inFlight.pop_front();
+		}
+	}
+};
+
+class Peer {
+private:
+	Match match;
+	SnapshotHistory history{ ROLLBACK_FRAMES };
+	std::vector<Input> remote;
+	std::vector<bool> confirmed;
+	Input lastConfirmed;
+	Uint64 frame = 0;
+
+	Input remoteInput(Uint64 f) const {
+		return confirmed[f] ? remote[f] : lastConfirmed;
+	}
+
+	void simulate(Uint64 f) {
+		match.getWorld().saveSnapshot(history.record(f));
+
+		// Unconfirmed frames predict the remote player repeats its last known input.
+		remote[f] = remoteInput(f);
+		Input inputs[2] = { inputFor(0, f), remote[f] };
+		match.step(inputs);
+	}
+
+public:
+	size_t rollbacks = 0;
+	size_t deepestRollback = 0;
+
+	explicit Peer(StorageMode mode)
+		: match(mode)
+		, remote(FRAME_COUNT)
+		, confirmed(FRAME_COUNT, false)
+	{}
+
+	// Takes the real remote inputs that arrived and, if any was mispredicted,
+	// rolls back to the earliest of them and re-simulates to the present.
+	bool receive(Loopback& link, Uint64 now) {
+		Uint64 rollbackFrom = frame;
+
+		link.receive(now, [&](Uint64 f, Input input) {
+			if (f < frame && !(remote[f] == input))
+				rollbackFrom = std::min(rollbackFrom, f);
+
+			remote[f] = input;
+			confirmed[f] = true;
+			lastConfirmed = input;
+		});
+
+		if (rollbackFrom == frame)
+			return true;
+
+		const Snapshot* snapshot = history.find(rollbackFrom);
+		if (!snapshot) {
+			std::printf("frame %llu fell out of the snapshot history\n", static_cast<unsigned long long>(rollbackFrom));
+			return false;
+		}
+
+		match.getWorld().restoreSnapshot(*snapshot);
+
+		++rollbacks;
+		deepestRollback = std::max<size_t>(deepestRollback, frame - rollbackFrom + 1);
+
+		for (Uint64 f = rollbackFrom; f < frame; ++f)
+			simulate(f);
+
+		return true;
+	}
+
+	void advance() {
+		simulate(frame++);
+	}
+
+	std::string state() { return match.state(); }
+};
+
+bool run(StorageMode mode, const char* name) {
+	Match reference(mode);
+	Peer peer(mode);
+	Loopback link;
+
+	for (Uint64 frame = 0; frame < FRAME_COUNT; ++frame) {
+		link.send(frame, inputFor(1, frame));
+
+		if (!peer.receive(link, frame))
+			return false;
+
+		peer.advance();
+
+		Input inputs[2] = { inputFor(0, frame), inputFor(1, frame) };
+		reference.step(inputs);
+	}
+
+	if (!peer.receive(link, FRAME_COUNT - 1 + LATENCY))
+		return false;
+
+	bool matches = peer.state() == reference.state();
+
+	// Rolling back one frame is trivial; the test is only meaningful if late
+	// inputs forced the full 8 frames at least once.
+	bool deepEnough = peer.deepestRollback == ROLLBACK_FRAMES;
+
+	std::printf(
+		"%s: %zu rollbacks, deepest %zu frames, state %s\n",
+		name, peer.rollbacks, peer.deepestRollback, matches ? "matches" : "DIFFERS"
+	);
+
+	return matches && deepEnough;
+}
+
+} // namespace
+
+int main() {
+	bool passed = run(StorageMode::SparseSet, "SparseSet");
+	passed = run(StorageMode::Archetype, "Archetype") && passed;
+	return passed ? 0 : 1;
+}